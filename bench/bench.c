@@ -0,0 +1,485 @@
+// Benchmarks for the SDK's own overhead, run against tools/axion-mock.
+//
+//     make bench
+//     ./bench/bench -r 5000 -t 8 -w prices
+//
+// Three parts:
+//   - micro benchmarks of query and URL building, transfer setup,
+//     cJSON parse and free, and typed statement decoding;
+//   - an end-to-end pass per workload, covering every endpoint family,
+//     reporting requests/sec, p50/p99 latency and allocations per call;
+//   - peak RSS for the whole run.
+//
+// Allocations are counted by wrapping malloc, calloc, realloc, strdup and
+// strndup at link time (-Wl,--wrap=...), so only calls made from the SDK
+// and cJSON are seen; libcurl's own allocations are not.
+
+#include "axion_internal.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------
+// Allocation counting
+// ---------------------------------------------------------------------
+static uint64_t alloc_count = 0;
+static uint64_t alloc_bytes = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void *ptr, size_t size);
+char* __real_strdup(const char *s);
+char* __real_strndup(const char *s, size_t n);
+
+static void _count(size_t size) {
+    __atomic_add_fetch(&alloc_count, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&alloc_bytes, size, __ATOMIC_RELAXED);
+}
+
+void* __wrap_malloc(size_t size) {
+    _count(size);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    _count(count * size);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void *ptr, size_t size) {
+    _count(size);
+    return __real_realloc(ptr, size);
+}
+
+char* __wrap_strdup(const char *s) {
+    _count(strlen(s) + 1);
+    return __real_strdup(s);
+}
+
+char* __wrap_strndup(const char *s, size_t n) {
+    _count(n + 1);
+    return __real_strndup(s, n);
+}
+
+static uint64_t _allocs(void) {
+    return __atomic_load_n(&alloc_count, __ATOMIC_RELAXED);
+}
+
+// ---------------------------------------------------------------------
+// Options and helpers
+// ---------------------------------------------------------------------
+typedef struct {
+    const char *base_url;   // Existing server; NULL to start the mock
+    const char *mock;
+    const char *fixtures;
+    int port;
+    int requests;           // Calls per workload
+    int threads;
+    int records;            // Size of the mock's generated bodies
+    const char *only;       // Run workloads whose name contains this
+} BenchOptions;
+
+static BenchOptions options = { NULL, "tools/axion-mock", "tools/fixtures", 18080, 2000, 4, 20000, NULL };
+
+static double _now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int _compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+static double _percentile(const double *sorted, size_t count, double p) {
+    if (count == 0) return 0;
+    size_t i = (size_t)(p / 100.0 * (double)(count - 1) + 0.5);
+    return sorted[i < count ? i : count - 1];
+}
+
+static char* _read_file(const char *file, size_t *size) {
+    FILE *f = fopen(file, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *data = len >= 0 ? malloc((size_t)len + 1) : NULL;
+    if (data && fread(data, 1, (size_t)len, f) == (size_t)len) {
+        data[len] = 0;
+        *size = (size_t)len;
+    } else {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    return data;
+}
+
+// ---------------------------------------------------------------------
+// Mock server
+// ---------------------------------------------------------------------
+static pid_t mock_pid = 0;
+
+static int _port_open(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int ok = connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+    close(fd);
+    return ok;
+}
+
+static int _mock_start(void) {
+    char port[16], records[16];
+    snprintf(port, sizeof(port), "%d", options.port);
+    snprintf(records, sizeof(records), "%d", options.records);
+
+    mock_pid = fork();
+    if (mock_pid < 0) return -1;
+    if (mock_pid == 0) {
+        prctl(PR_SET_PDEATHSIG, SIGTERM);   // Never outlive a crashed benchmark
+        execl(options.mock, options.mock, "-p", port, "-d", options.fixtures, "-n", records, (char *)NULL);
+        fprintf(stderr, "error: cannot run %s; build it with 'make mock'.\n", options.mock);
+        _exit(127);
+    }
+
+    int i;
+    for (i = 0; i < 200; i++) {
+        if (_port_open(options.port)) return 0;
+        if (waitpid(mock_pid, NULL, WNOHANG) == mock_pid) break;
+        usleep(10000);
+    }
+    fprintf(stderr, "error: mock server did not start on port %d.\n", options.port);
+    return -1;
+}
+
+static void _mock_stop(void) {
+    if (mock_pid <= 0) return;
+    kill(mock_pid, SIGTERM);
+    waitpid(mock_pid, NULL, 0);
+    mock_pid = 0;
+}
+
+// ---------------------------------------------------------------------
+// Micro benchmarks
+// ---------------------------------------------------------------------
+static void _report_micro(const char *name, int iterations, double seconds, uint64_t allocs, double bytes) {
+    printf("  %-36s %10.1f ns/op %8.2f allocs/op", name, seconds * 1e9 / iterations, (double)allocs / iterations);
+    if (bytes > 0) printf(" %8.1f MB/s", bytes * iterations / seconds / 1e6);
+    printf("\n");
+}
+
+static void _bench_query(void) {
+    const char *keys[] = { "from", "to", "frame" };
+    const char *values[] = { "2024-01-01", "2024-12-31", "1d" };
+    const int iterations = 1000000;
+    uint64_t allocs = _allocs();
+    double start = _now();
+    int i;
+    for (i = 0; i < iterations; i++) free(_build_query(keys, values, 3));
+    _report_micro("_build_query (3 keys)", iterations, _now() - start, _allocs() - allocs, 0);
+}
+
+static void _bench_url(AxionClient *client) {
+    const int iterations = 1000000;
+    char url[2048];
+    uint64_t allocs = _allocs();
+    double start = _now();
+    int i;
+    for (i = 0; i < iterations; i++) {
+        _axion_build_url(client, url, sizeof(url), "stocks/AAPL/prices", "from=2024-01-01&to=2024-12-31");
+    }
+    _report_micro("_axion_build_url", iterations, _now() - start, _allocs() - allocs, 0);
+}
+
+// One transfer prepared and torn down without touching the network
+static void _bench_setup(AxionClient *client) {
+    const int iterations = 200000;
+    CURL *curl = _axion_handle_acquire(client);
+    if (!curl) return;
+    uint64_t allocs = _allocs();
+    double start = _now();
+    int i;
+    for (i = 0; i < iterations; i++) {
+        AxionTransfer transfer;
+        memset(&transfer, 0, sizeof(transfer));
+        transfer.response = _axion_response_new(client);
+        if (!transfer.response) break;
+        if (_axion_transfer_setup(client, curl, &transfer, "http://127.0.0.1/stocks/AAPL/prices") == 0) {
+            _axion_buffer_release(client, transfer.chunk.memory, transfer.chunk.capacity);
+        }
+        axion_response(transfer.response);
+    }
+    _report_micro("transfer setup + teardown", iterations, _now() - start, _allocs() - allocs, 0);
+    _axion_handle_release(client, curl);
+}
+
+static void _bench_parse(const char *name, const char *body, size_t size) {
+    if (!body || size == 0) return;
+    // Repeat for half a second, whatever the body's size
+    int iterations = 0;
+    uint64_t allocs = _allocs();
+    double start = _now();
+    while (iterations < 3 || _now() - start < 0.5) {
+        cJSON_Delete(cJSON_ParseWithLength(body, size));
+        iterations++;
+    }
+    char label[64];
+    snprintf(label, sizeof(label), "parse+free %s (%zu KB)", name, size / 1024);
+    _report_micro(label, iterations, _now() - start, _allocs() - allocs, (double)size);
+}
+
+static void _bench_parse_fixture(const char *name, const char *path) {
+    char file[1024];
+    snprintf(file, sizeof(file), "%s/%s", options.fixtures, path);
+    size_t size = 0;
+    char *body = _read_file(file, &size);
+    if (!body) {
+        fprintf(stderr, "warning: cannot read %s\n", file);
+        return;
+    }
+    _bench_parse(name, body, size);
+    free(body);
+}
+
+// Balance sheets read field by field from the tree, as callers did before
+// the typed decoders, against one pass with axion_decode_balance_sheets
+static void _bench_statements(const char *path) {
+    char file[1024];
+    snprintf(file, sizeof(file), "%s/%s", options.fixtures, path);
+    size_t size = 0;
+    char *body = _read_file(file, &size);
+    cJSON *json = body ? cJSON_ParseWithLength(body, size) : NULL;
+    free(body);
+    const cJSON *data = cJSON_GetObjectItemCaseSensitive(json, "data");
+    int count = cJSON_GetArraySize(data);
+    AxionBalanceSheet *sheets = count > 0 ? calloc((size_t)count, sizeof(AxionBalanceSheet)) : NULL;
+    if (!sheets) {
+        fprintf(stderr, "warning: cannot decode %s\n", file);
+        cJSON_Delete(json);
+        return;
+    }
+
+    const int iterations = 20000;
+    uint64_t allocs = _allocs();
+    double start = _now();
+    int i;
+    for (i = 0; i < iterations; i++) {
+        const cJSON *item;
+        AxionBalanceSheet *sheet = sheets;
+        cJSON_ArrayForEach(item, data) {
+#define LOOKUP(member, key) sheet->member = cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(item, key));
+            AXION_BALANCE_SHEET_FIELDS(LOOKUP)
+#undef LOOKUP
+            sheet++;
+        }
+    }
+    _report_micro("balance sheets by lookup", iterations, _now() - start, _allocs() - allocs, 0);
+
+    allocs = _allocs();
+    start = _now();
+    for (i = 0; i < iterations; i++) axion_decode_balance_sheets(json, sheets, (size_t)count);
+    _report_micro("balance sheets typed", iterations, _now() - start, _allocs() - allocs, 0);
+
+    free(sheets);
+    cJSON_Delete(json);
+}
+
+// ---------------------------------------------------------------------
+// End-to-end workloads
+// ---------------------------------------------------------------------
+typedef AxionResponse* (*BenchCall)(AxionClient *client);
+
+static AxionResponse* _reference(AxionClient *c) { return axion_stocks_tickers(c, NULL, NULL); }
+static AxionResponse* _profile(AxionClient *c) { return axion_profiles_profile(c, "AAPL"); }
+static AxionResponse* _holdings(AxionClient *c) { return axion_etfs_holdings_all(c, "SPY"); }
+static AxionResponse* _revenue(AxionClient *c) { return axion_financials_revenue(c, "AAPL", 0); }
+static AxionResponse* _transcript(AxionClient *c) { return axion_earnings_transcript(c, "AAPL", "2024", "1"); }
+static AxionResponse* _prices(AxionClient *c) { return axion_stocks_prices(c, "AAPL", NULL, NULL, NULL); }
+static AxionResponse* _prices_large(AxionClient *c) { return axion_stocks_prices(c, "BENCH", NULL, NULL, NULL); }
+static AxionResponse* _quote(AxionClient *c) { return axion_stocks_quote(c, "AAPL"); }
+static AxionResponse* _news(AxionClient *c) { return axion_news_general(c); }
+static AxionResponse* _econ(AxionClient *c) { return axion_econ_search(c, "gdp"); }
+
+static const struct {
+    const char *name;
+    const char *family;
+    BenchCall call;
+} workloads[] = {
+    { "reference", "reference", _reference },
+    { "profile", "profiles", _profile },
+    { "holdings-all", "profiles", _holdings },
+    { "revenue", "fundamentals", _revenue },
+    { "transcript", "fundamentals", _transcript },
+    { "prices", "prices", _prices },
+    { "prices-large", "prices", _prices_large },
+    { "quote", "quotes", _quote },
+    { "news", "news", _news },
+    { "econ-search", "other", _econ },
+};
+
+typedef struct {
+    AxionClient *client;
+    BenchCall call;
+    double *latencies;
+    int count;
+    int errors;
+} BenchWorker;
+
+static void* _worker(void *arg) {
+    BenchWorker *worker = (BenchWorker *)arg;
+    int i;
+    for (i = 0; i < worker->count; i++) {
+        double start = _now();
+        AxionResponse *response = worker->call(worker->client);
+        worker->latencies[i] = (_now() - start) * 1000.0;
+        if (!response || response->error) worker->errors++;
+        axion_response(response);
+    }
+    return NULL;
+}
+
+static void _run_workload(AxionClient *client, size_t w) {
+    int threads = options.threads;
+    int per_thread = options.requests / threads;
+    if (per_thread < 1) per_thread = 1;
+    int total = per_thread * threads;
+
+    double *latencies = malloc((size_t)total * sizeof(double));
+    BenchWorker *workers = calloc((size_t)threads, sizeof(BenchWorker));
+    pthread_t *ids = calloc((size_t)threads, sizeof(pthread_t));
+    if (!latencies || !workers || !ids) {
+        fprintf(stderr, "error: out of memory.\n");
+        exit(1);
+    }
+
+    // Warm the connection pool and the mock's body cache first
+    axion_response(workloads[w].call(client));
+
+    uint64_t allocs = _allocs();
+    double start = _now();
+    int t, errors = 0;
+    for (t = 0; t < threads; t++) {
+        workers[t].client = client;
+        workers[t].call = workloads[w].call;
+        workers[t].latencies = latencies + (size_t)t * per_thread;
+        workers[t].count = per_thread;
+        pthread_create(&ids[t], NULL, _worker, &workers[t]);
+    }
+    for (t = 0; t < threads; t++) {
+        pthread_join(ids[t], NULL);
+        errors += workers[t].errors;
+    }
+    double elapsed = _now() - start;
+    // The bench's own thread bookkeeping is a handful of allocations; ignore it
+    double per_call = (double)(_allocs() - allocs) / total;
+
+    qsort(latencies, (size_t)total, sizeof(double), _compare_doubles);
+    printf("  %-14s %-13s %10.0f %9.2f %9.2f %12.1f %7d\n", workloads[w].name, workloads[w].family,
+           total / elapsed, _percentile(latencies, total, 50), _percentile(latencies, total, 99), per_call, errors);
+    free(latencies);
+    free(workers);
+    free(ids);
+}
+
+// ---------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------
+static void _usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [-u base_url] [-r requests] [-t threads] [-n records] [-w workload] [-p port]\n"
+            "  -u  benchmark an existing server instead of starting tools/axion-mock\n"
+            "  -r  calls per workload (default 2000)\n"
+            "  -t  concurrent threads per workload (default 4)\n"
+            "  -n  bars in the mock's generated price history (default 20000)\n"
+            "  -w  only run workloads whose name contains this\n"
+            "  -p  port for the mock server (default 18080)\n",
+            argv0);
+}
+
+int main(int argc, char **argv) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    int opt;
+    while ((opt = getopt(argc, argv, "u:r:t:n:w:p:m:f:h")) != -1) {
+        switch (opt) {
+        case 'u': options.base_url = optarg; break;
+        case 'r': options.requests = atoi(optarg); break;
+        case 't': options.threads = atoi(optarg); break;
+        case 'n': options.records = atoi(optarg); break;
+        case 'w': options.only = optarg; break;
+        case 'p': options.port = atoi(optarg); break;
+        case 'm': options.mock = optarg; break;
+        case 'f': options.fixtures = optarg; break;
+        default:
+            _usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (options.threads < 1) options.threads = 1;
+    if (options.requests < 1) options.requests = 1;
+
+    char base_url[256];
+    if (options.base_url) {
+        snprintf(base_url, sizeof(base_url), "%s", options.base_url);
+    } else {
+        if (_mock_start() != 0) {
+            _mock_stop();
+            return 1;
+        }
+        snprintf(base_url, sizeof(base_url), "http://127.0.0.1:%d", options.port);
+    }
+
+    axion_global_init();
+    AxionClient *client = axion_init("bench");
+    if (!client || axion_set_base_url(client, base_url) != 0) {
+        _mock_stop();
+        return 1;
+    }
+    // Measure the client, not the coalescing of identical concurrent calls
+    axion_set_single_flight(client, 0);
+    axion_set_max_in_flight(client, options.threads);
+
+    printf("micro benchmarks\n");
+    _bench_query();
+    _bench_url(client);
+    _bench_setup(client);
+    _bench_parse_fixture("prices", "stocks/AAPL/prices.json");
+    _bench_parse_fixture("holdings", "etfs/SPY/holdings/all.json");
+    _bench_parse_fixture("transcript", "earnings/AAPL/transcript.json");
+    _bench_statements("financials/statements/_/balance.json");
+    AxionResponse *large = _prices_large(client);
+    if (large && large->data) _bench_parse("generated", large->data, strlen(large->data));
+    axion_response(large);
+
+    printf("\nend to end against %s, %d calls on %d threads per workload\n", base_url,
+           options.requests / options.threads * options.threads, options.threads);
+    printf("  %-14s %-13s %10s %9s %9s %12s %7s\n", "workload", "family", "req/s", "p50 ms", "p99 ms",
+           "allocs/call", "errors");
+    size_t w;
+    for (w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++) {
+        if (options.only && !strstr(workloads[w].name, options.only)) continue;
+        _run_workload(client, w);
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("\npeak RSS: %ld KB\n", usage.ru_maxrss);
+
+    axion_client(client);
+    axion_global_cleanup();
+    _mock_stop();
+    return 0;
+}
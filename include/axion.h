@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 // Forward declare cJSON to avoid including the full header in the public API
 struct cJSON;
@@ -12,7 +13,11 @@ struct cJSON;
  * @struct AxionClient
  * @brief  Holds the client configuration, including the API key and base URL.
  *
- * This struct is intended to be opaque to the user.
+ * This struct is intended to be opaque to the user. A single client may be
+ * used from many threads at once: each call borrows an easy handle from the
+ * client's pool, and all handles share one DNS and TLS session cache. Open
+ * connections are not shared between threads (libcurl does not support
+ * that); each pooled handle keeps its own and reuses them on later calls.
  */
 typedef struct AxionClient AxionClient;
 
@@ -27,6 +32,23 @@ typedef struct {
     char *error;
 } AxionResponse;
 
+/**
+ * @brief Initializes process-wide libcurl and TLS state.
+ *
+ * @return 0 on success, -1 on failure.
+ *
+ * Optional. Clients initialize this state on demand and tear it down when the
+ * last one is freed; calling this once at startup keeps it alive for the life
+ * of the process so short-lived clients do not rebuild it. Each call must be
+ * paired with axion_global_cleanup().
+ */
+int axion_global_init(void);
+
+/**
+ * @brief Releases the reference taken by axion_global_init().
+ */
+void axion_global_cleanup(void);
+
 /**
  * @brief Initializes a new Axion client.
  *
@@ -37,6 +59,18 @@ typedef struct {
  */
 AxionClient* axion_init(const char *api_key);
 
+/**
+ * @brief Creates a lightweight copy of an existing client.
+ *
+ * @param client The client to copy.
+ * @return A new client with the same configuration that shares the original's
+ *         DNS and TLS session cache, or NULL on failure.
+ *
+ * The clone is independent of the original: either may be freed first. The
+ * returned client must be freed using axion_client().
+ */
+AxionClient* axion_client_clone(AxionClient *client);
+
 /**
  * @brief Frees all resources used by the Axion client.
  *
@@ -44,6 +78,109 @@ AxionClient* axion_init(const char *api_key);
  */
 void axion_client(AxionClient *client);
 
+/**
+ * @brief Points the client at another server, e.g. a local mock.
+ *
+ * @param client The Axion client.
+ * @param base_url Scheme, host and optional port and path prefix, such as
+ *                 "http://127.0.0.1:8080". NULL restores the default,
+ *                 https://api.axionquant.com.
+ * @return 0 on success, -1 if the URL is not http:// or https:// or on
+ *         allocation failure.
+ *
+ * Set it before the client is shared between threads. Clones inherit it.
+ * Plain http:// connections use HTTP/1.1 and are never multiplexed.
+ */
+int axion_set_base_url(AxionClient *client, const char *base_url);
+
+/**
+ * @brief Phases of a call, timed for every network transfer.
+ *
+ * DNS through TRANSFER come from the last attempt; a reused connection
+ * spends no time in DNS, CONNECT or TLS. TOTAL is the whole call, including
+ * retries, backoff and rate limit waits. PARSE is only recorded in the
+ * endpoint statistics for calls that built a JSON tree.
+ */
+typedef enum {
+    AXION_PHASE_DNS = 0,    // Name lookup
+    AXION_PHASE_CONNECT,    // TCP connect
+    AXION_PHASE_TLS,        // TLS handshake
+    AXION_PHASE_TTFB,       // Request sent until the first response byte
+    AXION_PHASE_TRANSFER,   // First byte until the body is complete
+    AXION_PHASE_PARSE,      // cJSON parse of the body
+    AXION_PHASE_TOTAL,
+    AXION_PHASE_COUNT
+} AxionPhase;
+
+/**
+ * @brief Transfer statistics for one response.
+ */
+typedef struct {
+    uint64_t wire_bytes;    // Body bytes received from the network, still encoded
+    uint64_t decoded_bytes; // Body bytes after decompression
+    char encoding[16];      // Content-Encoding of the body, "" if none
+    uint64_t header_bytes;  // Status line and headers received
+    uint64_t request_bytes; // Request line and headers sent
+    uint64_t phase_us[AXION_PHASE_COUNT];   // Microseconds spent in each phase
+} AxionResponseStats;
+
+/**
+ * @brief Copies a response's transfer statistics into *stats.
+ *
+ * @return 0 on success, -1 if either argument is NULL.
+ *
+ * Responses served from the cache or shared with a coalesced call report
+ * zero bytes and times.
+ */
+int axion_response_stats(const AxionResponse *response, AxionResponseStats *stats);
+
+/**
+ * @brief Enables or disables compressed responses (enabled by default).
+ *
+ * @param client The Axion client.
+ * @param enabled Non-zero to send Accept-Encoding with every encoding the
+ *                linked libcurl can decode (gzip, deflate, br, zstd).
+ *
+ * Bodies are decompressed as they arrive, before buffering or streaming.
+ */
+void axion_set_compression(AxionClient *client, int enabled);
+
+/**
+ * @brief Chooses what a successful response keeps.
+ */
+typedef enum {
+    AXION_RESPONSE_DEFAULT = 0, // Keep the raw body in data and the parsed tree in json
+    AXION_RESPONSE_RAW_ONLY,    // Keep data only; json is NULL and no parse is done
+    AXION_RESPONSE_PARSED_ONLY, // Keep json only; the body is freed after parsing
+    AXION_RESPONSE_IN_SITU      // Keep json only; its strings point into the retained
+                                // body instead of being copied out of it
+} AxionResponseMode;
+
+/**
+ * @brief Sets the response mode for subsequent calls (default AXION_RESPONSE_DEFAULT).
+ *
+ * @param client The Axion client.
+ * @param mode The response mode.
+ *
+ * In AXION_RESPONSE_IN_SITU mode the tree's strings must not be modified or
+ * freed individually; axion_response() releases them with the response.
+ */
+void axion_set_response_mode(AxionClient *client, AxionResponseMode mode);
+
+/**
+ * @brief Allocates each response from its own arena.
+ *
+ * @param client The Axion client.
+ * @param chunk_size Size of the arena's first chunk in bytes (later chunks
+ *        double); 0 disables arenas and restores per-object malloc.
+ *
+ * With an arena, the response, its body buffer and every node of its cJSON
+ * tree are bump-allocated from a few large chunks, and axion_response()
+ * releases them all at once. The json tree must then be treated as
+ * read-only: do not cJSON_Delete, detach, replace or add items in it.
+ */
+void axion_set_arena(AxionClient *client, size_t chunk_size);
+
 /**
  * @brief Frees the memory allocated for an AxionResponse.
  *
@@ -51,6 +188,375 @@ void axion_client(AxionClient *client);
  */
 void axion_response(AxionResponse *response);
 
+// =====================================================================
+// CACHE API
+// =====================================================================
+
+/**
+ * @brief Groups of endpoints that share a cache lifetime.
+ */
+typedef enum {
+    AXION_FAMILY_REFERENCE = 0, // Ticker lists, list/ lookups and axion_*_ticker (default 24h)
+    AXION_FAMILY_PROFILES,      // Profiles, ETF fund data, ownership, ESG, supply chain (default 1h)
+    AXION_FAMILY_FUNDAMENTALS,  // Financials, earnings and filings (default 1h)
+    AXION_FAMILY_PRICES,        // Historical prices (default: not cached)
+    AXION_FAMILY_QUOTES,        // Quotes, gainers and losers (default: not cached)
+    AXION_FAMILY_NEWS,          // News and sentiment (default: not cached)
+    AXION_FAMILY_OTHER,         // Everything else (default: not cached)
+    AXION_FAMILY_COUNT
+} AxionEndpointFamily;
+
+/**
+ * @brief Turns on a response cache keyed by the request path and query.
+ *
+ * @param client The Axion client.
+ * @param max_entries Entries kept in memory before the least recently used
+ *                    is evicted; 0 picks a default of 1024.
+ * @param disk_dir Optional existing directory for a second, on-disk tier
+ *                 that survives restarts. Can be NULL.
+ * @return 0 on success, -1 on failure.
+ *
+ * Only successful (HTTP 200) responses from families with a non-zero TTL
+ * are cached. Cached responses share their data and json with the cache
+ * and must be treated as read-only. The cache is shared with clients made
+ * by axion_client_clone() afterwards.
+ */
+int axion_cache_enable(AxionClient *client, size_t max_entries, const char *disk_dir);
+
+/**
+ * @brief Sets how long responses from one endpoint family stay cached.
+ *
+ * @param client The Axion client.
+ * @param family The endpoint family.
+ * @param ttl_seconds Lifetime in seconds; 0 stops caching the family.
+ */
+void axion_cache_set_ttl(AxionClient *client, AxionEndpointFamily family, int ttl_seconds);
+
+/**
+ * @brief Revalidates expired cache entries instead of re-downloading them.
+ *
+ * @param client The Axion client.
+ * @param enabled Non-zero to send If-None-Match / If-Modified-Since.
+ *
+ * Needs axion_cache_enable(). Responses carrying an ETag or Last-Modified
+ * header are kept past their TTL, even in families with a TTL of 0, and
+ * the next call sends a conditional request. A 304 answer returns the
+ * cached data and json without downloading or parsing the body again.
+ */
+void axion_set_conditional_requests(AxionClient *client, int enabled);
+
+/**
+ * @brief Drops every entry from the in-memory tier of the cache.
+ */
+void axion_cache_clear(AxionClient *client);
+
+/**
+ * @brief Enables or disables coalescing of identical in-flight calls (disabled by default).
+ *
+ * @param client The Axion client.
+ * @param enabled Non-zero to coalesce, zero to always perform every call.
+ *
+ * While a call is on the wire, any other thread on the same client asking
+ * for the same path and query waits for it instead of sending its own
+ * request. Each caller still gets its own AxionResponse and frees it with
+ * axion_response() as usual, but coalesced responses share their data and
+ * json and must be treated as read-only. Batches and streamed calls are
+ * never coalesced.
+ */
+void axion_set_single_flight(AxionClient *client, int enabled);
+
+// =====================================================================
+// RETRY API
+// =====================================================================
+
+/**
+ * @brief Configures automatic retries (3 attempts, 100 ms base, 10 s cap by default).
+ *
+ * @param client The Axion client.
+ * @param max_attempts Tries per call including the first; 1 disables retries.
+ * @param base_delay_ms Backoff ceiling before the first retry; it doubles
+ *                      for each later retry.
+ * @param max_delay_ms Cap on the backoff ceiling and on any Retry-After.
+ *
+ * HTTP 408, 429, 500, 502, 503 and 504 answers and transient network
+ * errors (connect, DNS, timeout, reset) are retried, after a random delay
+ * between 0 and the current ceiling. A Retry-After header raises the delay
+ * to what the server asked for. If it asks for longer than max_delay_ms,
+ * the answer is returned instead. Values <= 0 restore the defaults. Batches
+ * retry their failed entries the same way, without holding up the rest.
+ */
+void axion_set_retry(AxionClient *client, int max_attempts, int base_delay_ms, int max_delay_ms);
+
+/**
+ * @brief Hedges slow quote calls (disabled by default).
+ *
+ * @param client The Axion client.
+ * @param delay_ms If a *_quote call has not answered after this long, an
+ *                 identical request is sent and the first successful
+ *                 answer wins; 0 disables hedging.
+ *
+ * Set it near the quote endpoint's 95th percentile latency. Only the slow
+ * tail pays for a second request.
+ */
+void axion_set_hedging(AxionClient *client, int delay_ms);
+
+/**
+ * @brief Caps the request rate for every call made with the client's API key (unlimited by default).
+ *
+ * @param client The Axion client.
+ * @param requests_per_second Sustained rate; <= 0 removes the limit.
+ * @param burst Requests that may go out back to back after an idle spell.
+ *
+ * Calls over the limit wait their turn instead of being sent and throttled
+ * with a 429. Batches keep running their other entries while one waits.
+ * Only requests that reach the network count, so cache hits and coalesced
+ * calls are free, and retries count like any other request. A call that a
+ * deadline or cancel token ends while it waits gives its turn back. The
+ * limiter is lock-free and is shared by clones, as they share the API key.
+ */
+void axion_set_rate_limit(AxionClient *client, double requests_per_second, int burst);
+
+/**
+ * @brief Caps the request rate for one endpoint family, on top of axion_set_rate_limit().
+ *
+ * @param client The Axion client.
+ * @param family The endpoint family to limit.
+ * @param requests_per_second Sustained rate; <= 0 removes the limit.
+ * @param burst Requests that may go out back to back after an idle spell.
+ */
+void axion_set_family_rate_limit(AxionClient *client, AxionEndpointFamily family,
+                                 double requests_per_second, int burst);
+
+// =====================================================================
+// TIMEOUT API
+// =====================================================================
+
+/**
+ * @brief Sets the client's transfer timeouts.
+ *
+ * @param client The Axion client.
+ * @param connect_timeout_ms Limit for connecting (default 10 s); 0 leaves
+ *                           curl's built-in limit.
+ * @param timeout_ms Limit for each whole attempt (default none); 0 for none.
+ * @param stall_timeout_ms Abort an attempt that receives less than 1 byte/s
+ *                         for this long (default 30 s, rounded up to whole
+ *                         seconds); 0 never aborts.
+ *
+ * Negative values restore the defaults. A timed-out attempt is retried
+ * like any other transient failure; see axion_set_retry().
+ */
+void axion_set_timeouts(AxionClient *client, int connect_timeout_ms, int timeout_ms, int stall_timeout_ms);
+
+/**
+ * @brief Gives every call made on the calling thread from now on a shared time budget.
+ *
+ * @param timeout_ms Budget in milliseconds from now; 0 removes the deadline.
+ *
+ * The budget covers everything a call does: waiting for the rate limiter,
+ * every attempt and the backoff between them. A call still running when
+ * the deadline passes is aborted with error "Deadline exceeded.", and
+ * retries that could not finish in time are not started. The deadline
+ * stays in force for later calls on the thread until it is replaced or
+ * removed. It also applies to batches performed and iterators opened on
+ * the thread.
+ */
+void axion_set_deadline(int timeout_ms);
+
+/**
+ * @struct AxionCancelToken
+ * @brief  A flag that aborts in-flight calls when raised from any thread.
+ */
+typedef struct AxionCancelToken AxionCancelToken;
+
+/**
+ * @brief Creates a cancel token. Free it with axion_cancel_token().
+ */
+AxionCancelToken* axion_cancel_token_new(void);
+
+/**
+ * @brief Watches a cancel token in every call made on the calling thread.
+ *
+ * @param token The token, or NULL to stop watching. It must outlive the
+ *              calls that watch it.
+ *
+ * Once axion_cancel() is called on the token, running transfers abort at
+ * their next progress check (at most about a second, sooner while data is
+ * arriving), pending retries and rate-limit waits end, and new requests
+ * fail at once with error "Request cancelled.". This lasts until another
+ * token is set.
+ */
+void axion_set_cancel_token(AxionCancelToken *token);
+
+/**
+ * @brief Raises a cancel token. Thread-safe; may be called from any thread.
+ */
+void axion_cancel(AxionCancelToken *token);
+
+/**
+ * @brief Returns non-zero once axion_cancel() has been called on the token.
+ */
+int axion_cancelled(const AxionCancelToken *token);
+
+/**
+ * @brief Frees a cancel token.
+ *
+ * @param token The token to free.
+ */
+void axion_cancel_token(AxionCancelToken *token);
+
+// =====================================================================
+// STATS API
+// =====================================================================
+
+#define AXION_ENDPOINT_NAME_MAX 64
+#define AXION_STATS_BUCKETS 256
+
+/**
+ * @brief Counters and latency histograms for one endpoint, or one family.
+ *
+ * Each phase has a log-linear histogram of microseconds: exact below 8 us,
+ * then every power of two split into 8 buckets, so any value is resolved to
+ * within 12.5%. Read it with axion_stats_percentile().
+ */
+typedef struct {
+    char endpoint[AXION_ENDPOINT_NAME_MAX];  // Path template, e.g. "stocks/%s/prices"; "" for a family
+    AxionEndpointFamily family;
+    uint64_t calls;         // Network transfers; cache hits and coalesced calls are not counted
+    uint64_t errors;        // Calls that returned with an error set
+    uint64_t bytes_in;      // Headers and still-encoded bodies received
+    uint64_t bytes_out;     // Request lines and headers sent
+    uint64_t sum_us[AXION_PHASE_COUNT];
+    uint64_t max_us[AXION_PHASE_COUNT];
+    uint32_t histogram[AXION_PHASE_COUNT][AXION_STATS_BUCKETS];
+} AxionEndpointStats;
+
+/**
+ * @brief Copies the statistics of every endpoint the client has called.
+ *
+ * @param client The Axion client.
+ * @param out Array to fill. Can be NULL to only count.
+ * @param max Capacity of out.
+ * @return Number of endpoints recorded, which may exceed max.
+ *
+ * Statistics are shared with clients made by axion_client_clone().
+ * Recording is lock-free and always on. Each record is about 7 KB, so
+ * allocate out on the heap.
+ */
+size_t axion_stats(AxionClient *client, AxionEndpointStats *out, size_t max);
+
+/**
+ * @brief Sums the statistics of every endpoint in a family.
+ *
+ * @return 0 on success, -1 on bad arguments or allocation failure.
+ */
+int axion_stats_family(AxionClient *client, AxionEndpointFamily family, AxionEndpointStats *out);
+
+/**
+ * @brief Returns a latency percentile in milliseconds.
+ *
+ * @param stats Statistics from axion_stats() or axion_stats_family().
+ * @param phase The phase to read.
+ * @param percentile 0 to 100, e.g. 99.9.
+ * @return The percentile, or 0 if nothing has been recorded.
+ */
+double axion_stats_percentile(const AxionEndpointStats *stats, AxionPhase phase, double percentile);
+
+/**
+ * @brief Returns the mean time spent in a phase, in milliseconds, over the calls that recorded it.
+ */
+double axion_stats_mean(const AxionEndpointStats *stats, AxionPhase phase);
+
+/**
+ * @brief Zeroes every counter and histogram, keeping the endpoints known.
+ *
+ * Calls finishing while the reset runs may be partly counted.
+ */
+void axion_stats_reset(AxionClient *client);
+
+// =====================================================================
+// BATCH API
+// =====================================================================
+
+/**
+ * @struct AxionBatch
+ * @brief  A set of endpoint calls performed concurrently over a curl multi handle.
+ *
+ * Between axion_batch_begin() and axion_batch_perform(), every axion_* call made
+ * on the same thread with the batch's client is queued instead of performed, and
+ * returns a pending AxionResponse that is filled in by axion_batch_perform().
+ * The batch may be performed or freed on any thread.
+ */
+typedef struct AxionBatch AxionBatch;
+
+/**
+ * @brief Called by axion_batch_perform() as each queued call completes.
+ *
+ * @param response The completed response (still owned by the caller).
+ * @param index    The position of the call in the order it was queued.
+ * @param userdata The pointer passed to axion_batch_perform().
+ */
+typedef void (*AxionBatchCallback)(AxionResponse *response, size_t index, void *userdata);
+
+/**
+ * @brief Sets how many transfers a batch keeps in flight at once (default 16).
+ *
+ * @param client The Axion client.
+ * @param max_in_flight Maximum concurrent transfers; values <= 0 restore the default.
+ */
+void axion_set_max_in_flight(AxionClient *client, int max_in_flight);
+
+/**
+ * @brief Configures HTTP/2 use (enabled by default, 100 streams per connection).
+ *
+ * @param client The Axion client.
+ * @param enabled Non-zero to prefer HTTP/2 over TLS and multiplex batch
+ *                transfers over shared connections; zero forces HTTP/1.1.
+ * @param max_streams Concurrent streams per connection before another
+ *                    connection is opened; values <= 0 restore the default.
+ *
+ * To run a whole batch over one connection, raise axion_set_max_in_flight()
+ * to match max_streams.
+ */
+void axion_set_http2(AxionClient *client, int enabled, int max_streams);
+
+/**
+ * @brief Starts recording a batch of calls on the calling thread.
+ *
+ * @param client The Axion client whose calls should be queued.
+ * @return A new batch, or NULL if this thread is already recording one for the client.
+ */
+AxionBatch* axion_batch_begin(AxionClient *client);
+
+/**
+ * @brief Stops recording and performs every queued call concurrently.
+ *
+ * @param batch The batch to perform.
+ * @param on_complete Optional callback invoked in completion order. Can be NULL.
+ * @param userdata Passed through to on_complete.
+ * @return The number of calls that completed with an error, or -1 on failure.
+ *
+ * The pending responses must not be freed before this returns. Afterwards
+ * each one is owned by the caller and freed with axion_response() as usual.
+ */
+int axion_batch_perform(AxionBatch *batch, AxionBatchCallback on_complete, void *userdata);
+
+/**
+ * @brief Returns the number of calls queued in the batch.
+ */
+size_t axion_batch_size(const AxionBatch *batch);
+
+/**
+ * @brief Returns the response for the index-th queued call, in queue order.
+ */
+AxionResponse* axion_batch_response(AxionBatch *batch, size_t index);
+
+/**
+ * @brief Frees the batch itself. Responses are not freed.
+ *
+ * @param batch The batch to free.
+ */
+void axion_batch_free(AxionBatch *batch);
+
 /**
  * @brief Get a single stock ticker by its ticker symbol.
  *
@@ -75,6 +581,439 @@ AxionResponse* axion_get_stock_ticker_by_symbol(AxionClient *client, const char
 AxionResponse* axion_get_stock_prices(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame);
 
 
+// =====================================================================
+// STREAMING PRICES API
+// =====================================================================
+
+/**
+ * @struct AxionBar
+ * @brief  One price bar, delivered while the response is still downloading.
+ *
+ * Fields missing from the payload are NAN.
+ */
+typedef struct {
+    const char *date;   // Date string as sent by the API, NULL for numeric timestamps.
+                        // Only valid for the duration of the callback.
+    int64_t timestamp;  // Seconds since the Unix epoch (UTC)
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume;
+} AxionBar;
+
+/**
+ * @brief Called once per bar, in the order bars appear in the response.
+ *
+ * @return 0 to continue, non-zero to stop the transfer early (not an error).
+ */
+typedef int (*AxionBarCallback)(const AxionBar *bar, void *userdata);
+
+/**
+ * @brief Streams historical prices, parsing bars as bytes arrive.
+ *
+ * Takes the same arguments as the matching *_prices call plus a callback.
+ * The body is never buffered or turned into a cJSON tree, so memory use stays
+ * flat regardless of the date range. The returned response carries only
+ * http_status and error; data and json are always NULL. Streamed calls are
+ * never queued by a batch.
+ */
+AxionResponse* axion_stocks_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata);
+AxionResponse* axion_etfs_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata);
+AxionResponse* axion_crypto_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata);
+AxionResponse* axion_forex_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata);
+AxionResponse* axion_futures_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata);
+AxionResponse* axion_indices_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata);
+
+// =====================================================================
+// LIST ITERATOR API
+// =====================================================================
+
+/**
+ * @struct AxionIterator
+ * @brief  Lazily walks the items of a list endpoint.
+ *
+ * The list is downloaded on a background thread and split into items as
+ * bytes arrive, so the caller can process one item while the next ones are
+ * still in flight. At most about 1 MB of unread items is buffered; beyond
+ * that the download pauses until the caller catches up. Because the caller
+ * sets the pace, the stall and total timeouts of axion_set_timeouts() do
+ * not apply to the download; a deadline or cancel token still does.
+ */
+typedef struct AxionIterator AxionIterator;
+
+/**
+ * @brief Returns the next item, or NULL when the list is exhausted or failed.
+ *
+ * The item is owned by the iterator and stays valid until the next call to
+ * axion_iter_next() or axion_iter_free().
+ */
+struct cJSON* axion_iter_next(AxionIterator *it);
+
+/**
+ * @brief Returns the error that ended the iteration, or NULL if it completed.
+ *
+ * Only meaningful once axion_iter_next() has returned NULL. An item that
+ * fails to parse also ends the iteration and is reported here, so a NULL
+ * from this function means every item in the list was returned.
+ */
+const char* axion_iter_error(const AxionIterator *it);
+
+/**
+ * @brief Returns the HTTP status of the list request once it has ended.
+ */
+int axion_iter_status(const AxionIterator *it);
+
+/**
+ * @brief Frees the iterator, stopping the download if it is still running.
+ */
+void axion_iter_free(AxionIterator *it);
+
+/**
+ * Iterable variants of the list endpoints; they take the same arguments as
+ * the matching call without the _iter suffix.
+ */
+AxionIterator* axion_stocks_tickers_iter(AxionClient *client, const char *country, const char *exchange);
+AxionIterator* axion_etfs_tickers_iter(AxionClient *client, const char *country, const char *exchange);
+AxionIterator* axion_crypto_tickers_iter(AxionClient *client, const char *type);
+AxionIterator* axion_forex_tickers_iter(AxionClient *client, const char *country, const char *exchange);
+AxionIterator* axion_futures_tickers_iter(AxionClient *client, const char *exchange);
+AxionIterator* axion_indices_tickers_iter(AxionClient *client, const char *exchange);
+AxionIterator* axion_filings_history_iter(AxionClient *client, const char *ticker, const char *form_type,
+                                          const char *start_date, const char *end_date);
+AxionIterator* axion_news_general_iter(AxionClient *client);
+AxionIterator* axion_news_company_iter(AxionClient *client, const char *ticker);
+AxionIterator* axion_news_country_iter(AxionClient *client, const char *country);
+AxionIterator* axion_news_category_iter(AxionClient *client, const char *category);
+
+// =====================================================================
+// PRICE SERIES API
+// =====================================================================
+
+/**
+ * @struct AxionPriceSeries
+ * @brief  Historical prices as contiguous, 64-byte aligned columns.
+ *
+ * Bar i is (timestamp[i], open[i], high[i], low[i], close[i], volume[i]).
+ * Values missing from the payload are NAN. On failure count is 0 and error
+ * is set, exactly as for an AxionResponse.
+ */
+typedef struct {
+    size_t count;
+    int64_t *timestamp; // Seconds since the Unix epoch (UTC)
+    double *open;
+    double *high;
+    double *low;
+    double *close;
+    double *volume;
+    int http_status;
+    char *error;
+} AxionPriceSeries;
+
+/**
+ * @brief Fetches historical prices straight into a typed AxionPriceSeries.
+ *
+ * Takes the same arguments as the matching *_prices call. Bars are decoded
+ * from the body as it arrives, without building a cJSON tree. The caller is
+ * responsible for freeing the series with axion_price_series().
+ */
+AxionPriceSeries* axion_stocks_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame);
+AxionPriceSeries* axion_etfs_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame);
+AxionPriceSeries* axion_crypto_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame);
+AxionPriceSeries* axion_forex_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame);
+AxionPriceSeries* axion_futures_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame);
+AxionPriceSeries* axion_indices_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame);
+
+/**
+ * @brief Frees the memory allocated for an AxionPriceSeries.
+ *
+ * @param series The series to free.
+ */
+void axion_price_series(AxionPriceSeries *series);
+
+// =====================================================================
+// QUOTES API
+// =====================================================================
+
+/**
+ * @struct AxionQuote
+ * @brief  A decoded quote for one ticker.
+ *
+ * Fields missing from the payload are NAN; timestamp is 0 when absent. A
+ * ticker that failed has error set and leaves the other quotes untouched.
+ * ticker is a copy of the requested ticker for display and is cut to fit;
+ * the request itself always uses the full ticker.
+ */
+typedef struct {
+    char ticker[32];
+    double price;
+    double change;
+    double change_percent;
+    double open;
+    double high;
+    double low;
+    double previous_close;
+    double volume;
+    int64_t timestamp;  // Seconds since the Unix epoch (UTC)
+    int http_status;
+    char *error;
+} AxionQuote;
+
+/**
+ * @struct AxionQuotes
+ * @brief  Quotes in the same order as the requested tickers.
+ */
+typedef struct {
+    size_t count;
+    AxionQuote *quotes;
+    size_t failed;      // Number of quotes with error set
+} AxionQuotes;
+
+/**
+ * @brief Fetches quotes for many tickers at once.
+ *
+ * The requests run concurrently as one batch, so they share connections
+ * (and HTTP/2 streams) and are bounded by axion_set_max_in_flight(). Must
+ * not be called while the same thread is recording a batch for the client.
+ * Returns NULL only if the call could not be set up. The caller is
+ * responsible for freeing the result with axion_quotes().
+ */
+AxionQuotes* axion_stocks_quotes(AxionClient *client, const char **tickers, size_t count);
+AxionQuotes* axion_etfs_quotes(AxionClient *client, const char **tickers, size_t count);
+AxionQuotes* axion_crypto_quotes(AxionClient *client, const char **tickers, size_t count);
+AxionQuotes* axion_forex_quotes(AxionClient *client, const char **tickers, size_t count);
+AxionQuotes* axion_futures_quotes(AxionClient *client, const char **tickers, size_t count);
+AxionQuotes* axion_indices_quotes(AxionClient *client, const char **tickers, size_t count);
+
+/**
+ * @brief Frees the memory allocated for an AxionQuotes.
+ *
+ * @param quotes The quotes to free.
+ */
+void axion_quotes(AxionQuotes *quotes);
+
+// =====================================================================
+// TYPED FUNDAMENTALS API
+// =====================================================================
+
+/*
+ * Field lists for the typed statements, as X-macros of (member, JSON key).
+ * Each list generates the double members of its struct below, and can be
+ * expanded again to walk the fields generically. Keys match regardless of
+ * case and separators, so "totalAssets", "total_assets" and "TotalAssets"
+ * all fill total_assets, as does the member's own name.
+ */
+#define AXION_BALANCE_SHEET_FIELDS(X) \
+    X(cash_and_equivalents, "cashAndCashEquivalents") \
+    X(short_term_investments, "shortTermInvestments") \
+    X(receivables, "netReceivables") \
+    X(inventory, "inventory") \
+    X(total_current_assets, "totalCurrentAssets") \
+    X(property_plant_equipment, "propertyPlantEquipmentNet") \
+    X(goodwill, "goodwill") \
+    X(intangible_assets, "intangibleAssets") \
+    X(long_term_investments, "longTermInvestments") \
+    X(total_non_current_assets, "totalNonCurrentAssets") \
+    X(total_assets, "totalAssets") \
+    X(accounts_payable, "accountPayables") \
+    X(short_term_debt, "shortTermDebt") \
+    X(deferred_revenue, "deferredRevenue") \
+    X(total_current_liabilities, "totalCurrentLiabilities") \
+    X(long_term_debt, "longTermDebt") \
+    X(total_non_current_liabilities, "totalNonCurrentLiabilities") \
+    X(total_liabilities, "totalLiabilities") \
+    X(common_stock, "commonStock") \
+    X(retained_earnings, "retainedEarnings") \
+    X(stockholders_equity, "totalStockholdersEquity") \
+    X(total_debt, "totalDebt") \
+    X(net_debt, "netDebt")
+
+#define AXION_INCOME_STATEMENT_FIELDS(X) \
+    X(revenue, "revenue") \
+    X(cost_of_revenue, "costOfRevenue") \
+    X(gross_profit, "grossProfit") \
+    X(research_and_development, "researchAndDevelopmentExpenses") \
+    X(selling_general_admin, "sellingGeneralAndAdministrativeExpenses") \
+    X(operating_expenses, "operatingExpenses") \
+    X(operating_income, "operatingIncome") \
+    X(interest_expense, "interestExpense") \
+    X(ebitda, "ebitda") \
+    X(income_before_tax, "incomeBeforeTax") \
+    X(income_tax_expense, "incomeTaxExpense") \
+    X(net_income, "netIncome") \
+    X(eps, "eps") \
+    X(eps_diluted, "epsDiluted") \
+    X(shares_outstanding_basic, "weightedAverageShsOut") \
+    X(shares_outstanding_diluted, "weightedAverageShsOutDil")
+
+#define AXION_CASH_FLOW_STATEMENT_FIELDS(X) \
+    X(net_income, "netIncome") \
+    X(depreciation_and_amortization, "depreciationAndAmortization") \
+    X(stock_based_compensation, "stockBasedCompensation") \
+    X(change_in_working_capital, "changeInWorkingCapital") \
+    X(operating_cash_flow, "operatingCashFlow") \
+    X(capital_expenditures, "capitalExpenditure") \
+    X(acquisitions, "acquisitionsNet") \
+    X(investing_cash_flow, "investingCashFlow") \
+    X(debt_repayment, "debtRepayment") \
+    X(share_repurchases, "commonStockRepurchased") \
+    X(dividends_paid, "dividendsPaid") \
+    X(financing_cash_flow, "financingCashFlow") \
+    X(net_change_in_cash, "netChangeInCash") \
+    X(free_cash_flow, "freeCashFlow")
+
+#define AXION_METRICS_FIELDS(X) \
+    X(market_cap, "marketCap") \
+    X(enterprise_value, "enterpriseValue") \
+    X(pe_ratio, "peRatio") \
+    X(forward_pe, "forwardPE") \
+    X(peg_ratio, "pegRatio") \
+    X(price_to_book, "priceToBook") \
+    X(price_to_sales, "priceToSales") \
+    X(ev_to_ebitda, "evToEbitda") \
+    X(ev_to_revenue, "evToRevenue") \
+    X(gross_margin, "grossMargin") \
+    X(operating_margin, "operatingMargin") \
+    X(profit_margin, "profitMargin") \
+    X(return_on_assets, "returnOnAssets") \
+    X(return_on_equity, "returnOnEquity") \
+    X(debt_to_equity, "debtToEquity") \
+    X(current_ratio, "currentRatio") \
+    X(quick_ratio, "quickRatio") \
+    X(dividend_yield, "dividendYield") \
+    X(payout_ratio, "payoutRatio") \
+    X(revenue_growth, "revenueGrowth") \
+    X(earnings_growth, "earningsGrowth") \
+    X(book_value_per_share, "bookValuePerShare") \
+    X(free_cash_flow_yield, "freeCashFlowYield") \
+    X(beta, "beta")
+
+#define AXION_SNAPSHOT_FIELDS(X) \
+    X(price, "price") \
+    X(market_cap, "marketCap") \
+    X(shares_outstanding, "sharesOutstanding") \
+    X(revenue, "revenue") \
+    X(net_income, "netIncome") \
+    X(ebitda, "ebitda") \
+    X(eps, "eps") \
+    X(pe_ratio, "peRatio") \
+    X(dividend_yield, "dividendYield") \
+    X(beta, "beta") \
+    X(fifty_two_week_high, "fiftyTwoWeekHigh") \
+    X(fifty_two_week_low, "fiftyTwoWeekLow") \
+    X(total_cash, "totalCash") \
+    X(total_debt, "totalDebt") \
+    X(free_cash_flow, "freeCashFlow") \
+    X(employees, "fullTimeEmployees")
+
+#define AXION_FIELD_MEMBER(member, key) double member;
+
+/**
+ * @struct AxionFiscalPeriod
+ * @brief  The period a statement covers. Empty strings and 0 when absent.
+ */
+typedef struct {
+    char date[16];      // End of the period, "YYYY-MM-DD"
+    char period[8];     // "FY", "Q1" .. "Q4"
+    int year;           // Fiscal year
+} AxionFiscalPeriod;
+
+typedef struct {
+    AxionFiscalPeriod fiscal;
+    AXION_BALANCE_SHEET_FIELDS(AXION_FIELD_MEMBER)
+} AxionBalanceSheet;
+
+typedef struct {
+    AxionFiscalPeriod fiscal;
+    AXION_INCOME_STATEMENT_FIELDS(AXION_FIELD_MEMBER)
+} AxionIncomeStatement;
+
+typedef struct {
+    AxionFiscalPeriod fiscal;
+    AXION_CASH_FLOW_STATEMENT_FIELDS(AXION_FIELD_MEMBER)
+} AxionCashFlowStatement;
+
+/**
+ * @brief  Decoded statements, one per period in the payload, in payload order.
+ *
+ * Fields missing from the payload are NAN. On failure count is 0 and error
+ * is set, exactly as for an AxionResponse.
+ */
+typedef struct {
+    size_t count;
+    AxionBalanceSheet *items;
+    int http_status;
+    char *error;
+} AxionBalanceSheets;
+
+typedef struct {
+    size_t count;
+    AxionIncomeStatement *items;
+    int http_status;
+    char *error;
+} AxionIncomeStatements;
+
+typedef struct {
+    size_t count;
+    AxionCashFlowStatement *items;
+    int http_status;
+    char *error;
+} AxionCashFlowStatements;
+
+/**
+ * @brief  Decoded key metrics and snapshot for one ticker.
+ *
+ * Fields missing from the payload are NAN; error is set on failure.
+ */
+typedef struct {
+    AXION_METRICS_FIELDS(AXION_FIELD_MEMBER)
+    int http_status;
+    char *error;
+} AxionMetrics;
+
+typedef struct {
+    AXION_SNAPSHOT_FIELDS(AXION_FIELD_MEMBER)
+    int http_status;
+    char *error;
+} AxionSnapshot;
+
+/**
+ * @brief Fetches fundamentals straight into typed structs.
+ *
+ * Takes the same arguments as the matching axion_financials_* call. Each
+ * object in the payload is decoded in one pass over its members, with a
+ * single hash probe per key, instead of one lookup per field. The caller is
+ * responsible for freeing the result with the matching free function below.
+ */
+AxionBalanceSheets* axion_financials_balance_sheet_typed(AxionClient *client, const char *ticker, const char *year, const char *quarter);
+AxionIncomeStatements* axion_financials_income_statement_typed(AxionClient *client, const char *ticker, const char *year, const char *quarter);
+AxionCashFlowStatements* axion_financials_cash_flow_statement_typed(AxionClient *client, const char *ticker, const char *year, const char *quarter);
+AxionMetrics* axion_financials_metrics_typed(AxionClient *client, const char *ticker);
+AxionSnapshot* axion_financials_snapshot_typed(AxionClient *client, const char *ticker);
+
+/**
+ * @brief Frees the memory allocated for typed fundamentals.
+ */
+void axion_balance_sheets(AxionBalanceSheets *statements);
+void axion_income_statements(AxionIncomeStatements *statements);
+void axion_cash_flow_statements(AxionCashFlowStatements *statements);
+void axion_metrics(AxionMetrics *metrics);
+void axion_snapshot(AxionSnapshot *snapshot);
+
+/**
+ * @brief Decodes an already parsed fundamentals payload, e.g. from a batch.
+ *
+ * The statement variants write up to max records to out and return how many
+ * the payload holds, like axion_stats(); the others return 0, or -1 if the
+ * payload is an empty list. All return -1 if json holds no object to
+ * decode. http_status and error are untouched.
+ */
+int axion_decode_balance_sheets(const struct cJSON *json, AxionBalanceSheet *out, size_t max);
+int axion_decode_income_statements(const struct cJSON *json, AxionIncomeStatement *out, size_t max);
+int axion_decode_cash_flow_statements(const struct cJSON *json, AxionCashFlowStatement *out, size_t max);
+int axion_decode_metrics(const struct cJSON *json, AxionMetrics *out);
+int axion_decode_snapshot(const struct cJSON *json, AxionSnapshot *out);
+
 // =====================================================================
 // CREDIT API
 // =====================================================================
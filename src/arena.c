@@ -0,0 +1,131 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#define ARENA_ALIGN 16
+#define ARENA_MAX_CHUNK ((size_t)64 * 1024 * 1024)
+
+typedef struct AxionArenaChunk {
+    struct AxionArenaChunk *next;
+    size_t size;
+    size_t used;
+    max_align_t data[];
+} AxionArenaChunk;
+
+struct AxionArena {
+    AxionArenaChunk *head;  // Chunk currently being filled; older ones follow
+    size_t next_size;       // Size of the next chunk, doubled as the arena grows
+    void *last;             // Most recent allocation, which can be extended or rolled back
+};
+
+static size_t _align(size_t n) {
+    return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+static AxionArenaChunk* _chunk_new(size_t size) {
+    AxionArenaChunk *chunk = malloc(sizeof(AxionArenaChunk) + size);
+    if (!chunk) return NULL;
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+// The arena lives at the front of its own first chunk, so creating one is a single malloc
+AxionArena* _axion_arena_new(size_t chunk_size) {
+    size_t header = _align(sizeof(AxionArena));
+    if (chunk_size < 4096) chunk_size = 4096;
+
+    AxionArenaChunk *chunk = _chunk_new(header + chunk_size);
+    if (!chunk) return NULL;
+
+    AxionArena *arena = (AxionArena *)chunk->data;
+    chunk->used = header;
+    arena->head = chunk;
+    arena->next_size = chunk_size * 2;
+    arena->last = NULL;
+    return arena;
+}
+
+void* _axion_arena_alloc(AxionArena *arena, size_t size) {
+    AxionArenaChunk *chunk = arena->head;
+    size = _align(size ? size : 1);
+
+    if (chunk->size - chunk->used < size) {
+        size_t chunk_size = arena->next_size;
+        if (chunk_size < size) chunk_size = size;
+        AxionArenaChunk *fresh = _chunk_new(chunk_size);
+        if (!fresh) return NULL;
+
+        // Keep the arena's own chunk last in the list so it is freed last
+        fresh->next = chunk;
+        arena->head = fresh;
+        if (arena->next_size < ARENA_MAX_CHUNK) arena->next_size *= 2;
+        chunk = fresh;
+    }
+
+    void *ptr = (char *)chunk->data + chunk->used;
+    chunk->used += size;
+    arena->last = ptr;
+    return ptr;
+}
+
+// Grows the most recent allocation in place when it fits, otherwise moves it
+void* _axion_arena_extend(AxionArena *arena, void *ptr, size_t old_size, size_t new_size) {
+    if (ptr && ptr == arena->last) {
+        AxionArenaChunk *chunk = arena->head;
+        size_t offset = (size_t)((char *)ptr - (char *)chunk->data);
+        if (offset + _align(new_size) <= chunk->size) {
+            chunk->used = offset + _align(new_size);
+            return ptr;
+        }
+    }
+
+    void *moved = _axion_arena_alloc(arena, new_size);
+    if (moved && ptr) memcpy(moved, ptr, old_size);
+    return moved;
+}
+
+// Individual frees are no-ops, except that the most recent allocation is
+// rolled back so short-lived scratch buffers do not accumulate
+void _axion_arena_release(AxionArena *arena, void *ptr) {
+    if (!ptr || ptr != arena->last) return;
+    AxionArenaChunk *chunk = arena->head;
+    chunk->used = (size_t)((char *)ptr - (char *)chunk->data);
+    arena->last = NULL;
+}
+
+void _axion_arena_free(AxionArena *arena) {
+    if (!arena) return;
+    AxionArenaChunk *chunk = arena->head;
+    while (chunk) {
+        AxionArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+}
+
+// ---------------------------------------------------------------------
+// cJSON allocation hooks
+// ---------------------------------------------------------------------
+// cJSON hooks carry no context pointer, so the target arena is per thread
+static _Thread_local AxionArena *hook_arena = NULL;
+
+static void* _hook_malloc(size_t size) {
+    return _axion_arena_alloc(hook_arena, size);
+}
+
+static void _hook_free(void *ptr) {
+    _axion_arena_release(hook_arena, ptr);
+}
+
+cJSON* _axion_arena_parse(AxionArena *arena, char *value, size_t length, int insitu) {
+    cJSON_Hooks hooks = { _hook_malloc, _hook_free };
+    AxionArena *previous = hook_arena;
+    hook_arena = arena;
+    cJSON *json = insitu ? cJSON_ParseInSitu(value, length, &hooks)
+                         : cJSON_ParseWithLengthHooks(value, length, &hooks);
+    hook_arena = previous;
+    return json;
+}
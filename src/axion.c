@@ -1,45 +1,65 @@
-#include "axion.h"
-#include "cJSON.h"
-#include <curl/curl.h>
+#include "axion_internal.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdio.h>
 
-#define BASE_URL "https://api.axionquant.com"
-
-// Opaque struct defined in the header
-struct AxionClient {
-    char *api_key;
-    CURL *curl_handle;
-};
-
-// Response struct
-struct AxionResponse {
-    int http_status;
-    char *data;
-    cJSON *json;
-    char *error;
-};
+// Grows the body buffer to hold at least `needed` bytes. Capacity doubles so
+// a body arriving in many small chunks is copied O(log n) times, and the
+// first chunk reserves the whole Content-Length when the server sent one.
+static int _axion_body_reserve(AxionTransfer *transfer, size_t needed) {
+    MemoryStruct *mem = &transfer->chunk;
+    if (needed <= mem->capacity) return 0;
+
+    size_t capacity = mem->capacity * 2;
+    if (capacity < needed) capacity = needed;
+    if (mem->size == 0) {
+        curl_off_t length = -1;
+        curl_easy_getinfo(transfer->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+        if (length > 0 && (size_t)length < AXION_MAX_BODY_PRESIZE && (size_t)length + 1 > capacity) {
+            capacity = (size_t)length + 1;
+        }
+    }
 
-// Struct to hold the response from curl
-typedef struct {
-    char *memory;
-    size_t size;
-} MemoryStruct;
+    char *ptr;
+    if (mem->arena) {
+        ptr = _axion_arena_extend(mem->arena, mem->memory, mem->size + 1, capacity);
+    } else {
+        ptr = realloc(mem->memory, capacity);
+    }
+    if (!ptr) return -1;
+    mem->memory = ptr;
+    mem->capacity = capacity;
+    return 0;
+}
 
 // Callback function for curl to write received data into a buffer
 static size_t write_memory_callback(void *contents, size_t size, size_t nmemb, void *userp) {
     size_t realsize = size * nmemb;
-    MemoryStruct *mem = (MemoryStruct *)userp;
+    AxionTransfer *transfer = (AxionTransfer *)userp;
+    MemoryStruct *mem = &transfer->chunk;
+    transfer->decoded_bytes += realsize;
+
+    // Successful bodies go straight to the streaming consumer, if any;
+    // error bodies are still buffered so their message can be reported
+    if (transfer->sink) {
+        long http_code = 0;
+        curl_easy_getinfo(transfer->curl, CURLINFO_RESPONSE_CODE, &http_code);
+        if (http_code < 400) {
+            int rc = transfer->sink->write(transfer->sink->ctx, (const char *)contents, realsize);
+            if (rc != 0) {
+                transfer->sink_status = rc;
+                return 0;
+            }
+            return realsize;
+        }
+    }
 
-    char *ptr = realloc(mem->memory, mem->size + realsize + 1);
-    if (ptr == NULL) {
+    if (_axion_body_reserve(transfer, mem->size + realsize + 1) != 0) {
         fprintf(stderr, "error: not enough memory (realloc returned NULL)\n");
         return 0;
     }
 
-    mem->memory = ptr;
     memcpy(&(mem->memory[mem->size]), contents, realsize);
     mem->size += realsize;
     mem->memory[mem->size] = 0;
@@ -47,95 +67,487 @@ static size_t write_memory_callback(void *contents, size_t size, size_t nmemb, v
     return realsize;
 }
 
-// Internal function to perform requests
-static AxionResponse* _axion_request(AxionClient *client, const char *path, const char *query_params) {
-    if (!client || !client->curl_handle) {
-        fprintf(stderr, "error: client not initialized.\n");
-        return NULL;
-    }
-
-    CURL *curl = client->curl_handle;
-    CURLcode res;
-
-    MemoryStruct chunk;
-    chunk.memory = malloc(1);
-    chunk.size = 0;
+AxionResponse* _axion_response_new(AxionClient *client) {
+    AxionResponseImpl *impl;
+    AxionArena *arena = NULL;
 
-    // Construct full URL
-    char full_url[2048];
-    if (query_params && strlen(query_params) > 0) {
-        snprintf(full_url, sizeof(full_url), "%s/%s?%s", BASE_URL, path, query_params);
+    if (client->arena_chunk > 0) {
+        arena = _axion_arena_new(client->arena_chunk);
+        if (!arena) return NULL;
+        impl = _axion_arena_alloc(arena, sizeof(AxionResponseImpl));
     } else {
-        snprintf(full_url, sizeof(full_url), "%s/%s", BASE_URL, path);
+        impl = malloc(sizeof(AxionResponseImpl));
     }
+    if (!impl) return NULL;
 
-    AxionResponse *response = malloc(sizeof(AxionResponse));
-    if (!response) return NULL;
+    impl->arena = arena;
+    impl->backing = NULL;
+    impl->payload = NULL;
+    memset(&impl->stats, 0, sizeof(impl->stats));
+    AxionResponse *response = &impl->pub;
     response->http_status = 0;
     response->data = NULL;
     response->json = NULL;
     response->error = NULL;
+    return response;
+}
+
+// Construct full URL; returns 0 on success, -1 if it did not fit
+int _axion_build_url(const AxionClient *client, char *buf, size_t size, const char *path,
+                     const char *query_params) {
+    const char *base = client->base_url ? client->base_url : BASE_URL;
+    int n;
+    if (query_params && strlen(query_params) > 0) {
+        n = snprintf(buf, size, "%s/%s?%s", base, path, query_params);
+    } else {
+        n = snprintf(buf, size, "%s/%s", base, path);
+    }
+    return (n < 0 || (size_t)n >= size) ? -1 : 0;
+}
+
+// ---------------------------------------------------------------------
+// Endpoint identity and body size hints
+// ---------------------------------------------------------------------
+// An endpoint is its path template with the first argument (the ticker,
+// series or entity id) left as a placeholder, so "stocks/%s/prices" is one
+// endpoint whatever the ticker while "financials/%s/revenue" and
+// "financials/%s/netincome" are two. Templates only take %s arguments.
+static uint32_t _hash_bytes(uint32_t hash, const char *s) {
+    while (*s) {
+        hash ^= (unsigned char)*s++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Also writes the endpoint's readable name to name: the template with every
+// argument but the first filled in, e.g. "financials/%s/revenue"
+static uint32_t _axion_endpoint_key(const char *fmt, va_list ap, char *name, size_t size) {
+    uint32_t hash = 2166136261u;
+    int arg = 0;
+    size_t len = 0;
+    const char *p, *v;
+    for (p = fmt; *p; p++) {
+        hash ^= (unsigned char)*p;
+        hash *= 16777619u;
+        if (p[0] == '%' && p[1] == 's') {
+            const char *value = va_arg(ap, const char *);
+            if (arg++ > 0 && value) {
+                hash = _hash_bytes(hash, value);
+                for (v = value; *v && len + 1 < size; v++) name[len++] = *v;
+                hash ^= (unsigned char)*++p;   // The 's', kept out of the name
+                hash *= 16777619u;
+                continue;
+            }
+        }
+        if (len + 1 < size) name[len++] = *p;
+    }
+    name[len] = 0;
+    return hash;
+}
+
+// Each slot packs the endpoint key and its last body size into one word,
+// so lookups and updates from many threads need no lock
+static size_t _axion_size_hint(AxionClient *client, uint32_t endpoint) {
+    uint64_t slot = __atomic_load_n(&client->size_hints[endpoint % AXION_SIZE_HINT_SLOTS], __ATOMIC_RELAXED);
+    return (uint32_t)(slot >> 32) == endpoint ? (size_t)(uint32_t)slot : 0;
+}
+
+static void _axion_size_hint_update(AxionClient *client, uint32_t endpoint, size_t size) {
+    if (size > UINT32_MAX) size = UINT32_MAX;
+    uint64_t slot = ((uint64_t)endpoint << 32) | (uint32_t)size;
+    __atomic_store_n(&client->size_hints[endpoint % AXION_SIZE_HINT_SLOTS], slot, __ATOMIC_RELAXED);
+}
+
+// Copies the client's headers and appends the conditions for a revalidation
+static struct curl_slist* _axion_conditional_headers(AxionClient *client, const AxionValidators *stale) {
+    struct curl_slist *headers = NULL;
+    const struct curl_slist *h;
+    for (h = client->headers; h; h = h->next) {
+        headers = curl_slist_append(headers, h->data);
+    }
+
+    char line[512];
+    if (stale->etag) {
+        snprintf(line, sizeof(line), "If-None-Match: %s", stale->etag);
+        headers = curl_slist_append(headers, line);
+    }
+    if (stale->last_modified) {
+        snprintf(line, sizeof(line), "If-Modified-Since: %s", stale->last_modified);
+        headers = curl_slist_append(headers, line);
+    }
+    return headers;
+}
+
+// Returns a copy of a response header's value, or NULL if it was not sent
+static char* _axion_header_dup(CURL *curl, const char *name) {
+    struct curl_header *header = NULL;
+    if (curl_easy_header(curl, name, 0, CURLH_HEADER, -1, &header) != CURLHE_OK) return NULL;
+    return strdup(header->value);
+}
 
-    curl_easy_setopt(curl, CURLOPT_URL, full_url);
+// Points an easy handle at a URL and wires its output into the transfer
+int _axion_transfer_setup(AxionClient *client, CURL *curl, AxionTransfer *transfer, const char *url) {
+    AxionArena *arena = AXION_IMPL(transfer->response)->arena;
+
+    // Buffered bodies start at the size this endpoint returned last time,
+    // plus some slack; streamed bodies only ever buffer error messages
+    size_t capacity = 1;
+    if (!transfer->sink) {
+        size_t hint = _axion_size_hint(client, transfer->endpoint);
+        if (hint > 0) capacity = hint + hint / 8 + 1;
+    }
+
+    transfer->client = client;
+    if (!transfer->started_us) transfer->started_us = _axion_now_us();
+    transfer->chunk.arena = arena;
+    transfer->chunk.size = 0;
+    if (arena) {
+        transfer->chunk.memory = _axion_arena_alloc(arena, capacity);
+        transfer->chunk.capacity = capacity;
+    } else {
+        transfer->chunk.memory = _axion_buffer_acquire(client, &capacity);
+        transfer->chunk.capacity = capacity;
+    }
+    transfer->curl = curl;
+    transfer->mode = client->response_mode;
+    transfer->sink_status = 0;
+    transfer->decoded_bytes = 0;
+    if (!transfer->chunk.memory) return -1;
+    transfer->chunk.memory[0] = 0;
+
+    curl_easy_setopt(curl, CURLOPT_URL, url);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_memory_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&chunk);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)transfer);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "axion-c-client/1.0");
+    // An empty string offers every encoding this libcurl was built with
+    // (gzip, deflate and, where available, br and zstd); bodies reach the
+    // write callback already decoded
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, client->compression ? "" : NULL);
+
+    // PIPEWAIT is only safe inside a multi handle (the batch engine turns it
+    // on); a blocking perform can wait forever on another thread's connection
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION,
+                     client->http2 ? (long)CURL_HTTP_VERSION_2TLS : (long)CURL_HTTP_VERSION_1_1);
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 0L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, 30L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, 15L);
+
+    // Stalled connections are dropped; the calling thread's deadline and
+    // cancel token, and the sink's stop flag, are also watched by the
+    // progress callback
+    _axion_call_limits(&transfer->limits);
+    transfer->abort_reason = NULL;
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, (long)client->connect_timeout_ms);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, _axion_call_timeout(client, transfer));
+    int stall_ms = (transfer->sink && transfer->sink->paced) ? 0 : client->stall_timeout_ms;
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, stall_ms > 0 ? 1L : 0L);
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, (long)(stall_ms + 999) / 1000);
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, _axion_progress);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, (void *)transfer);
+    int watched = transfer->limits.cancel || transfer->limits.deadline_ms || (transfer->sink && transfer->sink->stop);
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, watched ? 0L : 1L);
+
+    // Revalidating a stale cache entry adds its validators to this request only
+    transfer->etag = NULL;
+    transfer->last_modified = NULL;
+    transfer->headers = NULL;
+    if (transfer->revalidate.payload) {
+        transfer->headers = _axion_conditional_headers(client, &transfer->revalidate);
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer->headers ? transfer->headers : client->headers);
+    return 0;
+}
 
-    struct curl_slist *headers = NULL;
-    if (client->api_key) {
-        char auth_header[256];
-        snprintf(auth_header, sizeof(auth_header), "Authorization: Bearer %s", client->api_key);
-        headers = curl_slist_append(headers, auth_header);
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+// Parses a buffered body with the allocator and copy mode the transfer asked for
+static cJSON* _axion_parse_body(MemoryStruct *mem, int insitu) {
+    if (mem->arena) return _axion_arena_parse(mem->arena, mem->memory, mem->size + 1, insitu);
+    if (insitu) return cJSON_ParseInSitu(mem->memory, mem->size + 1, NULL);
+    return cJSON_ParseWithLength(mem->memory, mem->size + 1);
+}
+
+// Extracts the API's error message from a buffered error body
+static void _axion_set_http_error(AxionResponse *response) {
+    cJSON *error_json = cJSON_Parse(response->data);
+    if (error_json) {
+        cJSON *message = cJSON_GetObjectItemCaseSensitive(error_json, "message");
+        if (cJSON_IsString(message) && (message->valuestring != NULL)) {
+            response->error = strdup(message->valuestring);
+        } else {
+            response->error = strdup("An unknown HTTP error occurred.");
+        }
+        cJSON_Delete(error_json);
+    } else {
+         response->error = strdup("An unknown HTTP error occurred (failed to parse error response).");
+    }
+}
+
+// Returns a body the caller will not see to the client's spare buffers
+static void _axion_body_recycle(AxionTransfer *transfer) {
+    MemoryStruct *mem = &transfer->chunk;
+    if (mem->arena) {
+        _axion_body_free(mem);
+    } else {
+        _axion_buffer_release(transfer->client, mem->memory, mem->capacity);
     }
+    mem->memory = NULL;
+    mem->size = 0;
+}
+
+// Gives back the unused tail of a body that is handed to the caller, when a
+// generous size hint or doubling left much more room than the body needed
+static void _axion_body_trim(AxionTransfer *transfer) {
+    MemoryStruct *mem = &transfer->chunk;
+    if (mem->arena || mem->capacity / 2 <= mem->size + 1) return;
+    if (transfer->response->data != mem->memory) return;  // In-situ json points into it
 
-    res = curl_easy_perform(curl);
+    char *ptr = realloc(mem->memory, mem->size + 1);
+    if (!ptr) return;
+    transfer->response->data = ptr;
+    mem->memory = ptr;
+}
+
+// Records how many bytes crossed the wire, how many the body decoded to and
+// where the last attempt spent its time
+static void _axion_record_stats(CURL *curl, AxionTransfer *transfer) {
+    AxionResponseStats *stats = &AXION_IMPL(transfer->response)->stats;
+    curl_off_t wire = 0;
+    long header_bytes = 0, request_bytes = 0;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &wire);
+    curl_easy_getinfo(curl, CURLINFO_HEADER_SIZE, &header_bytes);
+    curl_easy_getinfo(curl, CURLINFO_REQUEST_SIZE, &request_bytes);
+    stats->wire_bytes = (uint64_t)wire;
+    stats->decoded_bytes = transfer->decoded_bytes;
+    stats->header_bytes = (uint64_t)header_bytes;
+    stats->request_bytes = (uint64_t)request_bytes;
+
+    // curl's timings are cumulative from the start of the attempt; phases a
+    // reused connection skipped report 0 and leave their neighbours unchanged
+    curl_off_t dns = 0, connect = 0, tls = 0, pretransfer = 0, first_byte = 0, total = 0;
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &dns);
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+    curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &tls);
+    curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME_T, &pretransfer);
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &first_byte);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+    stats->phase_us[AXION_PHASE_DNS] = (uint64_t)dns;
+    stats->phase_us[AXION_PHASE_CONNECT] = connect > dns ? (uint64_t)(connect - dns) : 0;
+    stats->phase_us[AXION_PHASE_TLS] = tls > connect ? (uint64_t)(tls - connect) : 0;
+    stats->phase_us[AXION_PHASE_TTFB] = first_byte > pretransfer ? (uint64_t)(first_byte - pretransfer) : 0;
+    stats->phase_us[AXION_PHASE_TRANSFER] = first_byte > 0 && total > first_byte ? (uint64_t)(total - first_byte) : 0;
+
+    struct curl_header *header = NULL;
+    if (curl_easy_header(curl, "Content-Encoding", 0, CURLH_HEADER, -1, &header) == CURLHE_OK) {
+        snprintf(stats->encoding, sizeof(stats->encoding), "%s", header->value);
+    }
+}
+
+// Fills the transfer's response from the finished easy handle
+void _axion_transfer_finish(CURL *curl, AxionTransfer *transfer, CURLcode res) {
+    AxionResponse *response = transfer->response;
+
+    // A streaming consumer asking to stop early is not a failure
+    if (res == CURLE_WRITE_ERROR && transfer->sink_status == 1) res = CURLE_OK;
+
+    if (transfer->headers) curl_slist_free_all(transfer->headers);
+    transfer->headers = NULL;
+    _axion_record_stats(curl, transfer);
 
     if (res != CURLE_OK) {
-        response->error = strdup(curl_easy_strerror(res));
+        const char *err = NULL;
+        if (transfer->sink_status < 0 && transfer->sink->finish) {
+            err = transfer->sink->finish(transfer->sink->ctx);
+        } else if (transfer->abort_reason) {
+            err = transfer->abort_reason;
+        } else if (res == CURLE_OPERATION_TIMEDOUT) {
+            // Timed out because the caller's deadline ran out, not the client's limit
+            transfer->abort_reason = _axion_call_expired(&transfer->limits);
+            err = transfer->abort_reason;
+        }
+        response->error = strdup(err ? err : curl_easy_strerror(res));
     } else {
         long http_code = 0;
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
         response->http_status = (int)http_code;
-        response->data = chunk.memory;
+
+        if (transfer->client->conditional && (http_code == 200 || http_code == 304)) {
+            transfer->etag = _axion_header_dup(curl, "ETag");
+            transfer->last_modified = _axion_header_dup(curl, "Last-Modified");
+        }
 
         if (http_code >= 400) {
-            cJSON *error_json = cJSON_Parse(response->data);
-            if (error_json) {
-                cJSON *message = cJSON_GetObjectItemCaseSensitive(error_json, "message");
-                if (cJSON_IsString(message) && (message->valuestring != NULL)) {
-                    response->error = strdup(message->valuestring);
-                } else {
-                    response->error = strdup("An unknown HTTP error occurred.");
-                }
-                cJSON_Delete(error_json);
-            } else {
-                 response->error = strdup("An unknown HTTP error occurred (failed to parse error response).");
+            response->data = transfer->chunk.memory;
+            _axion_set_http_error(response);
+        } else if (transfer->sink) {
+            // The body went to the sink; there is nothing to keep or parse
+            if (transfer->sink_status == 0 && transfer->sink->finish) {
+                const char *err = transfer->sink->finish(transfer->sink->ctx);
+                if (err) response->error = strdup(err);
             }
         } else {
-             response->json = cJSON_Parse(response->data);
-             if (!response->json && response->data && strlen(response->data) > 0) {
-                 response->error = strdup("Failed to parse JSON response.");
-             }
+            AxionResponseMode mode = transfer->mode;
+            _axion_size_hint_update(transfer->client, transfer->endpoint, transfer->chunk.size);
+            if (mode != AXION_RESPONSE_RAW_ONLY) {
+                int64_t parse_start = _axion_now_us();
+                response->json = _axion_parse_body(&transfer->chunk, mode == AXION_RESPONSE_IN_SITU);
+                AXION_IMPL(response)->stats.phase_us[AXION_PHASE_PARSE] = (uint64_t)(_axion_now_us() - parse_start);
+                if (!response->json && transfer->chunk.size > 0) {
+                    response->error = strdup("Failed to parse JSON response.");
+                }
+            }
+
+            if (mode == AXION_RESPONSE_IN_SITU && response->json) {
+                // The body now backs json's strings; it is kept but no longer JSON text
+                AXION_IMPL(response)->backing = transfer->chunk.memory;
+            } else if (mode != AXION_RESPONSE_PARSED_ONLY && mode != AXION_RESPONSE_IN_SITU) {
+                response->data = transfer->chunk.memory;
+            }
         }
     }
 
-    if (headers) curl_slist_free_all(headers);
     if (response->error && response->data) {
-        free(chunk.memory);
+        _axion_body_recycle(transfer);
         response->data = NULL;
-    } else if (!response->data) {
-        free(chunk.memory);
+    } else if (!response->data && !AXION_IMPL(response)->backing) {
+        _axion_body_recycle(transfer);
+    } else {
+        _axion_body_trim(transfer);
     }
+    transfer->chunk.memory = NULL;
+    transfer->chunk.size = 0;
+    transfer->chunk.capacity = 0;
 
-    return response;
+    AXION_IMPL(response)->stats.phase_us[AXION_PHASE_TOTAL] = (uint64_t)(_axion_now_us() - transfer->started_us);
+    _axion_stats_record(transfer->client, transfer);
+}
+
+// Releases a body buffer that is not being handed to the caller
+void _axion_body_free(MemoryStruct *mem) {
+    if (mem->arena) {
+        _axion_arena_release(mem->arena, mem->memory);
+    } else {
+        free(mem->memory);
+    }
+    mem->memory = NULL;
+    mem->size = 0;
+}
+
+// Internal function to perform requests, optionally streaming the body into a sink.
+// The path is built from a template; see _axion_endpoint_key for its arguments.
+AxionResponse* _axion_vrequest(AxionClient *client, const char *query_params, const AxionSink *sink,
+                               const char *fmt, va_list ap) {
+    if (!client || !client->share) {
+        fprintf(stderr, "error: client not initialized.\n");
+        return NULL;
+    }
+
+    char path[512];
+    char name[AXION_ENDPOINT_NAME_MAX];
+    va_list key_ap;
+    va_copy(key_ap, ap);
+    uint32_t endpoint = _axion_endpoint_key(fmt, key_ap, name, sizeof(name));
+    va_end(key_ap);
+    int n = vsnprintf(path, sizeof(path), fmt, ap);
+
+    char full_url[2048];
+    if (n < 0 || (size_t)n >= sizeof(path) ||
+        _axion_build_url(client, full_url, sizeof(full_url), path, query_params) != 0) {
+        fprintf(stderr, "error: request URL too long.\n");
+        return NULL;
+    }
+
+    // Inside axion_batch_begin() the call is queued instead of performed;
+    // streamed calls always run immediately and bypass the cache
+    AxionEndpointFamily family = _axion_endpoint_family(fmt);
+    if (!sink) {
+        AxionResponse *pending = _axion_batch_capture(client, endpoint, name, family, full_url);
+        if (pending) return pending;
+
+    }
+
+    AxionTransfer transfer;
+    memset(&transfer, 0, sizeof(transfer));
+    if (!sink) {
+        AxionPayload *cached = _axion_cache_get(client, family, full_url, &transfer.revalidate);
+        if (cached) {
+            AxionResponse *response = _axion_response_new(client);
+            if (response) _axion_response_attach(response, cached);
+            else _axion_payload_release(cached);
+            return response;
+        }
+    }
+
+    // An identical call already on the wire is waited for, not repeated
+    AxionFlight *flight = NULL;
+    while (!sink) {
+        int leader = 1;
+        flight = _axion_flight_join(client, full_url, &leader);
+        if (leader) break;
+        int rejoin = 0;
+        AxionResponse *response = _axion_flight_wait(client, flight, &rejoin);
+        if (!rejoin) {
+            _axion_validators_clear(&transfer.revalidate);
+            return response;
+        }
+    }
+
+    transfer.response = _axion_response_new(client);
+    transfer.endpoint = endpoint;
+    transfer.name = name;
+    transfer.family = family;
+    transfer.sink = sink;
+    if (!transfer.response) {
+        _axion_validators_clear(&transfer.revalidate);
+        _axion_flight_land(client, flight, NULL, 0);
+        return NULL;
+    }
+
+    // Each call borrows its own handle, so one client can serve many threads
+    CURL *curl = _axion_handle_acquire(client);
+    if (!curl) {
+        transfer.response->error = strdup("Failed to acquire a curl handle.");
+        _axion_validators_clear(&transfer.revalidate);
+        _axion_flight_land(client, flight, transfer.response, 0);
+        return transfer.response;
+    }
+    if (_axion_transfer_setup(client, curl, &transfer, full_url) != 0) {
+        transfer.response->error = strdup("Failed to allocate response buffer.");
+        _axion_validators_clear(&transfer.revalidate);
+        _axion_handle_release(client, curl);
+        _axion_flight_land(client, flight, transfer.response, 0);
+        return transfer.response;
+    }
+
+    CURLcode res = _axion_perform(client, &curl, &transfer, full_url, family);
+    _axion_transfer_finish(curl, &transfer, res);
+    _axion_handle_release(client, curl);
+    if (!sink) _axion_cache_complete(client, family, full_url, &transfer);
+    _axion_flight_land(client, flight, transfer.response, transfer.abort_reason != NULL);
+    return transfer.response;
+}
+
+AxionResponse* _axion_request_sink(AxionClient *client, const char *query_params, const AxionSink *sink,
+                                   const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    AxionResponse *resp = _axion_vrequest(client, query_params, sink, fmt, ap);
+    va_end(ap);
+    return resp;
+}
+
+static AxionResponse* _axion_requestf(AxionClient *client, const char *query_params, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    AxionResponse *resp = _axion_vrequest(client, query_params, NULL, fmt, ap);
+    va_end(ap);
+    return resp;
 }
 
 // ---------------------------------------------------------------------
 // Improved query builder - dynamically allocates exact needed memory
 // ---------------------------------------------------------------------
-static char* _build_query(const char **keys, const char **values, int count) {
+char* _build_query(const char **keys, const char **values, int count) {
     if (count == 0) return NULL;
 
     size_t needed = 1; // null terminator
@@ -165,67 +577,263 @@ static char* _build_query(const char **keys, const char **values, int count) {
 }
 
 // ---------------------------------------------------------------------
-// Client lifecycle
+// Process-wide curl state
 // ---------------------------------------------------------------------
-AxionClient* axion_init(const char *api_key) {
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-    CURL *curl = curl_easy_init();
-    if (!curl) {
-        fprintf(stderr, "error: curl_easy_init() failed.\n");
-        return NULL;
+static pthread_mutex_t global_lock = PTHREAD_MUTEX_INITIALIZER;
+static int global_refcount = 0;
+
+// curl_global_init/cleanup are not thread-safe and are expensive, so they
+// run only on the first acquire and the last release in the process
+int _axion_global_acquire(void) {
+    int rc = 0;
+    pthread_mutex_lock(&global_lock);
+    if (global_refcount == 0 && curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        fprintf(stderr, "error: curl_global_init() failed.\n");
+        rc = -1;
+    } else {
+        global_refcount++;
+    }
+    pthread_mutex_unlock(&global_lock);
+    return rc;
+}
+
+void _axion_global_release(void) {
+    pthread_mutex_lock(&global_lock);
+    if (global_refcount > 0 && --global_refcount == 0) {
+        curl_global_cleanup();
     }
+    pthread_mutex_unlock(&global_lock);
+}
+
+int axion_global_init(void) {
+    return _axion_global_acquire();
+}
 
+void axion_global_cleanup(void) {
+    _axion_global_release();
+}
+
+// ---------------------------------------------------------------------
+// Client lifecycle
+// ---------------------------------------------------------------------
+static AxionClient* _axion_client_new(const char *api_key, AxionShare *share) {
     AxionClient *client = malloc(sizeof(AxionClient));
     if (!client) {
         fprintf(stderr, "error: failed to allocate memory for client.\n");
-        curl_easy_cleanup(curl);
         return NULL;
     }
 
     client->api_key = api_key ? strdup(api_key) : NULL;
-    client->curl_handle = curl;
+    client->base_url = NULL;
+    client->headers = NULL;
+    client->max_in_flight = AXION_DEFAULT_MAX_IN_FLIGHT;
+    client->arena_chunk = 0;
+    client->response_mode = AXION_RESPONSE_DEFAULT;
+    client->compression = 1;
+    client->http2 = 1;
+    client->max_streams = AXION_DEFAULT_MAX_STREAMS;
+    client->max_attempts = AXION_DEFAULT_MAX_ATTEMPTS;
+    client->retry_base_ms = AXION_DEFAULT_RETRY_BASE_MS;
+    client->retry_max_ms = AXION_DEFAULT_RETRY_MAX_MS;
+    client->hedge_ms = 0;
+    client->limiter = NULL;
+    client->stats = NULL;
+    client->connect_timeout_ms = AXION_DEFAULT_CONNECT_TIMEOUT_MS;
+    client->timeout_ms = 0;
+    client->stall_timeout_ms = AXION_DEFAULT_STALL_TIMEOUT_MS;
+    client->share = share;
+    client->cache = NULL;
+    client->conditional = 0;
+    _axion_pool_init(client);
+    _axion_flight_init(client);
+    _axion_batch_init(client);
+
+    // Only reference data and slow-moving company data are cached by default
+    memset(client->cache_ttl, 0, sizeof(client->cache_ttl));
+    client->cache_ttl[AXION_FAMILY_REFERENCE] = 24 * 60 * 60;
+    client->cache_ttl[AXION_FAMILY_PROFILES] = 60 * 60;
+    client->cache_ttl[AXION_FAMILY_FUNDAMENTALS] = 60 * 60;
+
+    if (client->api_key) {
+        char auth_header[256];
+        snprintf(auth_header, sizeof(auth_header), "Authorization: Bearer %s", client->api_key);
+        client->headers = curl_slist_append(client->headers, auth_header);
+        client->headers = curl_slist_append(client->headers, "Content-Type: application/json");
+    }
     return client;
 }
 
+AxionClient* axion_init(const char *api_key) {
+    if (_axion_global_acquire() != 0) return NULL;
+
+    AxionShare *share = _axion_share_new();
+    if (!share) {
+        _axion_global_release();
+        return NULL;
+    }
+
+    AxionClient *client = _axion_client_new(api_key, share);
+    if (!client) {
+        _axion_share_release(share);
+        _axion_global_release();
+        return NULL;
+    }
+    client->limiter = _axion_limiter_new();
+    client->stats = _axion_stats_new();
+    return client;
+}
+
+AxionClient* axion_client_clone(AxionClient *client) {
+    if (!client) return NULL;
+    if (_axion_global_acquire() != 0) return NULL;
+
+    AxionClient *clone = _axion_client_new(client->api_key, _axion_share_retain(client->share));
+    if (!clone) {
+        _axion_share_release(client->share);
+        _axion_global_release();
+        return NULL;
+    }
+    if (client->base_url) clone->base_url = strdup(client->base_url);
+    clone->max_in_flight = client->max_in_flight;
+    clone->arena_chunk = client->arena_chunk;
+    clone->response_mode = client->response_mode;
+    clone->compression = client->compression;
+    clone->http2 = client->http2;
+    clone->max_streams = client->max_streams;
+    clone->max_attempts = client->max_attempts;
+    clone->retry_base_ms = client->retry_base_ms;
+    clone->retry_max_ms = client->retry_max_ms;
+    clone->hedge_ms = client->hedge_ms;
+    clone->limiter = _axion_limiter_retain(client->limiter);
+    clone->stats = _axion_stats_retain(client->stats);
+    clone->connect_timeout_ms = client->connect_timeout_ms;
+    clone->timeout_ms = client->timeout_ms;
+    clone->stall_timeout_ms = client->stall_timeout_ms;
+    clone->single_flight = client->single_flight;
+    clone->cache = _axion_cache_retain(client->cache);
+    memcpy(clone->cache_ttl, client->cache_ttl, sizeof(clone->cache_ttl));
+    clone->conditional = client->conditional;
+    return clone;
+}
+
 void axion_client(AxionClient *client) {
     if (!client) return;
     if (client->api_key) free(client->api_key);
-    if (client->curl_handle) curl_easy_cleanup(client->curl_handle);
+    free(client->base_url);
+    _axion_pool_cleanup(client);
+    _axion_flight_cleanup(client);
+    _axion_batch_cleanup(client);
+    _axion_cache_release(client->cache);
+    _axion_limiter_release(client->limiter);
+    _axion_stats_release(client->stats);
+    _axion_share_release(client->share);
+    if (client->headers) curl_slist_free_all(client->headers);
     free(client);
-    curl_global_cleanup();
+    _axion_global_release();
+}
+
+void axion_set_max_in_flight(AxionClient *client, int max_in_flight) {
+    if (!client) return;
+    client->max_in_flight = max_in_flight > 0 ? max_in_flight : AXION_DEFAULT_MAX_IN_FLIGHT;
+}
+
+void axion_set_arena(AxionClient *client, size_t chunk_size) {
+    if (!client) return;
+    client->arena_chunk = chunk_size;
+}
+
+void axion_set_response_mode(AxionClient *client, AxionResponseMode mode) {
+    if (!client) return;
+    client->response_mode = mode;
+}
+
+int axion_set_base_url(AxionClient *client, const char *base_url) {
+    if (!client) return -1;
+    if (!base_url) {
+        free(client->base_url);
+        client->base_url = NULL;
+        return 0;
+    }
+    if (strncmp(base_url, "https://", 8) != 0 && strncmp(base_url, "http://", 7) != 0) {
+        fprintf(stderr, "error: base URL must start with http:// or https://.\n");
+        return -1;
+    }
+
+    // Paths are joined with a '/', so a trailing one is dropped
+    size_t len = strlen(base_url);
+    while (len > 0 && base_url[len - 1] == '/') len--;
+    char *copy = strndup(base_url, len);
+    if (!copy) {
+        fprintf(stderr, "error: failed to allocate memory for base URL.\n");
+        return -1;
+    }
+    free(client->base_url);
+    client->base_url = copy;
+    return 0;
+}
+
+void axion_set_compression(AxionClient *client, int enabled) {
+    if (!client) return;
+    client->compression = enabled ? 1 : 0;
+}
+
+void axion_set_http2(AxionClient *client, int enabled, int max_streams) {
+    if (!client) return;
+    client->http2 = enabled ? 1 : 0;
+    client->max_streams = max_streams > 0 ? max_streams : AXION_DEFAULT_MAX_STREAMS;
+}
+
+int axion_response_stats(const AxionResponse *response, AxionResponseStats *stats) {
+    if (!response || !stats) return -1;
+    *stats = AXION_IMPL(response)->stats;
+    return 0;
 }
 
 void axion_response(AxionResponse *response) {
     if (!response) return;
+
+    // A shared payload owns data and json; other responses may still view it
+    AxionResponseImpl *impl = AXION_IMPL(response);
+    if (impl->payload) {
+        _axion_payload_release(impl->payload);
+        response->data = NULL;
+        response->json = NULL;
+    }
+
+    // Arena responses: body, tree and the response itself go in one free
+    if (impl->arena) {
+        if (response->error) free(response->error);
+        _axion_arena_free(impl->arena);
+        return;
+    }
+
     if (response->data) free(response->data);
     if (response->json) cJSON_Delete(response->json);
+    if (impl->backing) free(impl->backing);
     if (response->error) free(response->error);
     free(response);
 }
 
+
 // =====================================================================
 // CREDIT API
 // =====================================================================
 AxionResponse* axion_credit_search(AxionClient *client, const char *query) {
     char *q = _build_query((const char*[]){"query"}, (const char*[]){query}, 1);
-    AxionResponse *resp = _axion_request(client, "credit/search", q);
+    AxionResponse *resp = _axion_requestf(client, q, "credit/search");
     free(q);
     return resp;
 }
 
 AxionResponse* axion_credit_ratings(AxionClient *client, const char *entity_id) {
-    char path[256];
-    snprintf(path, sizeof(path), "credit/ratings/%s", entity_id);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "credit/ratings/%s", entity_id);
 }
 
 // =====================================================================
 // ESG API
 // =====================================================================
 AxionResponse* axion_esg_data(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "esg/%s", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "esg/%s", ticker);
 }
 
 // =====================================================================
@@ -235,7 +843,7 @@ AxionResponse* axion_etfs_tickers(AxionClient *client, const char *country, cons
     const char *keys[] = {"country", "exchange"};
     const char *values[] = {country, exchange};
     char *query = _build_query(keys, values, 2);
-    AxionResponse *resp = _axion_request(client, "etfs/tickers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "etfs/tickers");
     free(query);
     return resp;
 }
@@ -244,47 +852,33 @@ AxionResponse* axion_etfs_prices(AxionClient *client, const char *ticker, const
     const char *keys[] = {"from", "to", "frame"};
     const char *values[] = {from_date, to_date, frame};
     char *query = _build_query(keys, values, 3);
-    char path[256];
-    snprintf(path, sizeof(path), "etfs/%s/prices", ticker);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "etfs/%s/prices", ticker);
     free(query);
     return resp;
 }
 
 AxionResponse* axion_etfs_ticker(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "etfs/%s", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "etfs/%s", ticker);
 }
 
 AxionResponse* axion_etfs_fund(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "etfs/%s/fund", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "etfs/%s/fund", ticker);
 }
 
 AxionResponse* axion_etfs_holdings(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "etfs/%s/holdings", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "etfs/%s/holdings", ticker);
 }
 
 AxionResponse* axion_etfs_holdings_all(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "etfs/%s/holdings/all", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "etfs/%s/holdings/all", ticker);
 }
 
 AxionResponse* axion_etfs_exposure(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "etfs/%s/exposure", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "etfs/%s/exposure", ticker);
 }
 
 AxionResponse* axion_etfs_weights(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "etfs/%s/weights", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "etfs/%s/weights", ticker);
 }
 
 AxionResponse* axion_etfs_gainers(AxionClient *client, int days, int limit) {
@@ -301,7 +895,7 @@ AxionResponse* axion_etfs_gainers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "etfs/gainers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "etfs/gainers");
     free(query);
     return resp;
 }
@@ -320,60 +914,52 @@ AxionResponse* axion_etfs_losers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "etfs/losers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "etfs/losers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_etfs_list_market(AxionClient *client) {
-    return _axion_request(client, "etfs/list/market", NULL);
+    return _axion_requestf(client, NULL, "etfs/list/market");
 }
 
 AxionResponse* axion_etfs_list_country(AxionClient *client) {
-    return _axion_request(client, "etfs/list/country", NULL);
+    return _axion_requestf(client, NULL, "etfs/list/country");
 }
 
 AxionResponse* axion_etfs_list_currency(AxionClient *client) {
-    return _axion_request(client, "etfs/list/currency", NULL);
+    return _axion_requestf(client, NULL, "etfs/list/currency");
 }
 
 AxionResponse* axion_etfs_list_sector(AxionClient *client) {
-    return _axion_request(client, "etfs/list/sector", NULL);
+    return _axion_requestf(client, NULL, "etfs/list/sector");
 }
 
 AxionResponse* axion_etfs_list_industry(AxionClient *client) {
-    return _axion_request(client, "etfs/list/industry", NULL);
+    return _axion_requestf(client, NULL, "etfs/list/industry");
 }
 
 AxionResponse* axion_etfs_list_type(AxionClient *client) {
-    return _axion_request(client, "etfs/list/type", NULL);
+    return _axion_requestf(client, NULL, "etfs/list/type");
 }
 
 AxionResponse* axion_etfs_quote(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "etfs/%s/quote", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "etfs/%s/quote", ticker);
 }
 
 // =====================================================================
 // SUPPLY CHAIN API
 // =====================================================================
 AxionResponse* axion_supply_chain_customers(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "supply-chain/%s/customers", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "supply-chain/%s/customers", ticker);
 }
 
 AxionResponse* axion_supply_chain_peers(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "supply-chain/%s/peers", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "supply-chain/%s/peers", ticker);
 }
 
 AxionResponse* axion_supply_chain_suppliers(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "supply-chain/%s/suppliers", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "supply-chain/%s/suppliers", ticker);
 }
 
 // =====================================================================
@@ -383,24 +969,20 @@ AxionResponse* axion_stocks_tickers(AxionClient *client, const char *country, co
     const char *keys[] = {"country", "exchange"};
     const char *values[] = {country, exchange};
     char *query = _build_query(keys, values, 2);
-    AxionResponse *resp = _axion_request(client, "stocks/tickers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "stocks/tickers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_stocks_ticker(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "stocks/%s", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "stocks/%s", ticker);
 }
 
 AxionResponse* axion_stocks_prices(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
     const char *keys[] = {"from", "to", "frame"};
     const char *values[] = {from_date, to_date, frame};
     char *query = _build_query(keys, values, 3);
-    char path[256];
-    snprintf(path, sizeof(path), "stocks/%s/prices", ticker);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "stocks/%s/prices", ticker);
     free(query);
     return resp;
 }
@@ -422,7 +1004,7 @@ AxionResponse* axion_stocks_gainers(AxionClient *client, int days, int limit, co
         keys[count] = "market"; values[count++] = market;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "stocks/gainers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "stocks/gainers");
     free(query);
     return resp;
 }
@@ -444,39 +1026,37 @@ AxionResponse* axion_stocks_losers(AxionClient *client, int days, int limit, con
         keys[count] = "market"; values[count++] = market;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "stocks/losers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "stocks/losers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_stocks_list_market(AxionClient *client) {
-    return _axion_request(client, "stocks/list/market", NULL);
+    return _axion_requestf(client, NULL, "stocks/list/market");
 }
 
 AxionResponse* axion_stocks_list_country(AxionClient *client) {
-    return _axion_request(client, "stocks/list/country", NULL);
+    return _axion_requestf(client, NULL, "stocks/list/country");
 }
 
 AxionResponse* axion_stocks_list_currency(AxionClient *client) {
-    return _axion_request(client, "stocks/list/currency", NULL);
+    return _axion_requestf(client, NULL, "stocks/list/currency");
 }
 
 AxionResponse* axion_stocks_list_sector(AxionClient *client) {
-    return _axion_request(client, "stocks/list/sector", NULL);
+    return _axion_requestf(client, NULL, "stocks/list/sector");
 }
 
 AxionResponse* axion_stocks_list_industry(AxionClient *client) {
-    return _axion_request(client, "stocks/list/industry", NULL);
+    return _axion_requestf(client, NULL, "stocks/list/industry");
 }
 
 AxionResponse* axion_stocks_list_type(AxionClient *client) {
-    return _axion_request(client, "stocks/list/type", NULL);
+    return _axion_requestf(client, NULL, "stocks/list/type");
 }
 
 AxionResponse* axion_stocks_quote(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "stocks/%s/quote", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "stocks/%s/quote", ticker);
 }
 
 // Legacy aliases
@@ -495,24 +1075,20 @@ AxionResponse* axion_crypto_tickers(AxionClient *client, const char *type) {
     const char *keys[] = {"type"};
     const char *values[] = {type};
     char *query = _build_query(keys, values, 1);
-    AxionResponse *resp = _axion_request(client, "crypto/tickers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "crypto/tickers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_crypto_ticker(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "crypto/%s", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "crypto/%s", ticker);
 }
 
 AxionResponse* axion_crypto_prices(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
     const char *keys[] = {"from", "to", "frame"};
     const char *values[] = {from_date, to_date, frame};
     char *query = _build_query(keys, values, 3);
-    char path[256];
-    snprintf(path, sizeof(path), "crypto/%s/prices", ticker);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "crypto/%s/prices", ticker);
     free(query);
     return resp;
 }
@@ -531,7 +1107,7 @@ AxionResponse* axion_crypto_gainers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "crypto/gainers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "crypto/gainers");
     free(query);
     return resp;
 }
@@ -550,27 +1126,25 @@ AxionResponse* axion_crypto_losers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "crypto/losers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "crypto/losers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_crypto_list_category(AxionClient *client) {
-    return _axion_request(client, "crypto/list/category", NULL);
+    return _axion_requestf(client, NULL, "crypto/list/category");
 }
 
 AxionResponse* axion_crypto_list_rating(AxionClient *client) {
-    return _axion_request(client, "crypto/list/rating", NULL);
+    return _axion_requestf(client, NULL, "crypto/list/rating");
 }
 
 AxionResponse* axion_crypto_list_type(AxionClient *client) {
-    return _axion_request(client, "crypto/list/type", NULL);
+    return _axion_requestf(client, NULL, "crypto/list/type");
 }
 
 AxionResponse* axion_crypto_quote(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "crypto/%s/quote", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "crypto/%s/quote", ticker);
 }
 
 // =====================================================================
@@ -580,24 +1154,20 @@ AxionResponse* axion_forex_tickers(AxionClient *client, const char *country, con
     const char *keys[] = {"country", "exchange"};
     const char *values[] = {country, exchange};
     char *query = _build_query(keys, values, 2);
-    AxionResponse *resp = _axion_request(client, "forex/tickers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "forex/tickers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_forex_ticker(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "forex/%s", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "forex/%s", ticker);
 }
 
 AxionResponse* axion_forex_prices(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
     const char *keys[] = {"from", "to", "frame"};
     const char *values[] = {from_date, to_date, frame};
     char *query = _build_query(keys, values, 3);
-    char path[256];
-    snprintf(path, sizeof(path), "forex/%s/prices", ticker);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "forex/%s/prices", ticker);
     free(query);
     return resp;
 }
@@ -616,7 +1186,7 @@ AxionResponse* axion_forex_gainers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "forex/gainers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "forex/gainers");
     free(query);
     return resp;
 }
@@ -635,27 +1205,25 @@ AxionResponse* axion_forex_losers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "forex/losers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "forex/losers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_forex_list_exchange(AxionClient *client) {
-    return _axion_request(client, "forex/list/exchange", NULL);
+    return _axion_requestf(client, NULL, "forex/list/exchange");
 }
 
 AxionResponse* axion_forex_list_rating(AxionClient *client) {
-    return _axion_request(client, "forex/list/rating", NULL);
+    return _axion_requestf(client, NULL, "forex/list/rating");
 }
 
 AxionResponse* axion_forex_list_country(AxionClient *client) {
-    return _axion_request(client, "forex/list/country", NULL);
+    return _axion_requestf(client, NULL, "forex/list/country");
 }
 
 AxionResponse* axion_forex_quote(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "forex/%s/quote", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "forex/%s/quote", ticker);
 }
 
 // =====================================================================
@@ -665,24 +1233,20 @@ AxionResponse* axion_futures_tickers(AxionClient *client, const char *exchange)
     const char *keys[] = {"exchange"};
     const char *values[] = {exchange};
     char *query = _build_query(keys, values, 1);
-    AxionResponse *resp = _axion_request(client, "futures/tickers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "futures/tickers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_futures_ticker(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "futures/%s", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "futures/%s", ticker);
 }
 
 AxionResponse* axion_futures_prices(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
     const char *keys[] = {"from", "to", "frame"};
     const char *values[] = {from_date, to_date, frame};
     char *query = _build_query(keys, values, 3);
-    char path[256];
-    snprintf(path, sizeof(path), "futures/%s/prices", ticker);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "futures/%s/prices", ticker);
     free(query);
     return resp;
 }
@@ -701,7 +1265,7 @@ AxionResponse* axion_futures_gainers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "futures/gainers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "futures/gainers");
     free(query);
     return resp;
 }
@@ -720,31 +1284,29 @@ AxionResponse* axion_futures_losers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "futures/losers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "futures/losers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_futures_list_exchange(AxionClient *client) {
-    return _axion_request(client, "futures/list/exchange", NULL);
+    return _axion_requestf(client, NULL, "futures/list/exchange");
 }
 
 AxionResponse* axion_futures_list_currency(AxionClient *client) {
-    return _axion_request(client, "futures/list/currency", NULL);
+    return _axion_requestf(client, NULL, "futures/list/currency");
 }
 
 AxionResponse* axion_futures_list_timezone(AxionClient *client) {
-    return _axion_request(client, "futures/list/timezone", NULL);
+    return _axion_requestf(client, NULL, "futures/list/timezone");
 }
 
 AxionResponse* axion_futures_list_country(AxionClient *client) {
-    return _axion_request(client, "futures/list/country", NULL);
+    return _axion_requestf(client, NULL, "futures/list/country");
 }
 
 AxionResponse* axion_futures_quote(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "futures/%s/quote", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "futures/%s/quote", ticker);
 }
 
 // =====================================================================
@@ -754,24 +1316,20 @@ AxionResponse* axion_indices_tickers(AxionClient *client, const char *exchange)
     const char *keys[] = {"exchange"};
     const char *values[] = {exchange};
     char *query = _build_query(keys, values, 1);
-    AxionResponse *resp = _axion_request(client, "indices/tickers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "indices/tickers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_indices_ticker(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "indices/%s", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "indices/%s", ticker);
 }
 
 AxionResponse* axion_indices_prices(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
     const char *keys[] = {"from", "to", "frame"};
     const char *values[] = {from_date, to_date, frame};
     char *query = _build_query(keys, values, 3);
-    char path[256];
-    snprintf(path, sizeof(path), "indices/%s/prices", ticker);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "indices/%s/prices", ticker);
     free(query);
     return resp;
 }
@@ -790,7 +1348,7 @@ AxionResponse* axion_indices_gainers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "indices/gainers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "indices/gainers");
     free(query);
     return resp;
 }
@@ -809,39 +1367,33 @@ AxionResponse* axion_indices_losers(AxionClient *client, int days, int limit) {
         keys[count] = "limit"; values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "indices/losers", query);
+    AxionResponse *resp = _axion_requestf(client, query, "indices/losers");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_indices_list_exchange(AxionClient *client) {
-    return _axion_request(client, "indices/list/exchange", NULL);
+    return _axion_requestf(client, NULL, "indices/list/exchange");
 }
 
 AxionResponse* axion_indices_list_timezone(AxionClient *client) {
-    return _axion_request(client, "indices/list/timezone", NULL);
+    return _axion_requestf(client, NULL, "indices/list/timezone");
 }
 
 AxionResponse* axion_indices_list_country(AxionClient *client) {
-    return _axion_request(client, "indices/list/country", NULL);
+    return _axion_requestf(client, NULL, "indices/list/country");
 }
 
 AxionResponse* axion_indices_quote(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "indices/%s/quote", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "indices/%s/quote", ticker);
 }
 
 AxionResponse* axion_indices_components(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "indices/%s/components", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "indices/%s/components", ticker);
 }
 
 AxionResponse* axion_indices_exposure(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "indices/%s/exposure", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "indices/%s/exposure", ticker);
 }
 
 // =====================================================================
@@ -849,22 +1401,20 @@ AxionResponse* axion_indices_exposure(AxionClient *client, const char *ticker) {
 // =====================================================================
 AxionResponse* axion_econ_search(AxionClient *client, const char *query) {
     char *q = _build_query((const char*[]){"query"}, (const char*[]){query}, 1);
-    AxionResponse *resp = _axion_request(client, "econ/search", q);
+    AxionResponse *resp = _axion_requestf(client, q, "econ/search");
     free(q);
     return resp;
 }
 
 AxionResponse* axion_econ_find(AxionClient *client, const char *query) {
     char *q = _build_query((const char*[]){"query"}, (const char*[]){query}, 1);
-    AxionResponse *resp = _axion_request(client, "econ/find", q);
+    AxionResponse *resp = _axion_requestf(client, q, "econ/find");
     free(q);
     return resp;
 }
 
 AxionResponse* axion_econ_dataset(AxionClient *client, const char *series_id) {
-    char path[256];
-    snprintf(path, sizeof(path), "econ/dataset/%s", series_id);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "econ/dataset/%s", series_id);
 }
 
 AxionResponse* axion_econ_calendar(AxionClient *client,
@@ -899,7 +1449,7 @@ AxionResponse* axion_econ_calendar(AxionClient *client,
         free((char*)values[2]);
     }
 
-    AxionResponse *resp = _axion_request(client, "econ/calendar", query);
+    AxionResponse *resp = _axion_requestf(client, query, "econ/calendar");
     free(query);
     return resp;
 }
@@ -908,128 +1458,94 @@ AxionResponse* axion_econ_calendar(AxionClient *client,
 // NEWS API
 // =====================================================================
 AxionResponse* axion_news_general(AxionClient *client) {
-    return _axion_request(client, "news", NULL);
+    return _axion_requestf(client, NULL, "news");
 }
 
 AxionResponse* axion_news_company(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "news/%s", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "news/%s", ticker);
 }
 
 AxionResponse* axion_news_country(AxionClient *client, const char *country) {
-    char path[256];
-    snprintf(path, sizeof(path), "news/country/%s", country);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "news/country/%s", country);
 }
 
 AxionResponse* axion_news_category(AxionClient *client, const char *category) {
-    char path[256];
-    snprintf(path, sizeof(path), "news/category/%s", category);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "news/category/%s", category);
 }
 
 // =====================================================================
 // SENTIMENT API
 // =====================================================================
 AxionResponse* axion_sentiment_all(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "sentiment/%s/all", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "sentiment/%s/all", ticker);
 }
 
 AxionResponse* axion_sentiment_social(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "sentiment/%s/social", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "sentiment/%s/social", ticker);
 }
 
 AxionResponse* axion_sentiment_news(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "sentiment/%s/news", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "sentiment/%s/news", ticker);
 }
 
 AxionResponse* axion_sentiment_analyst(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "sentiment/%s/analyst", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "sentiment/%s/analyst", ticker);
 }
 
 // =====================================================================
 // PROFILES API
 // =====================================================================
 AxionResponse* axion_profiles_profile(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "profiles/%s", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "profiles/%s", ticker);
 }
 
 AxionResponse* axion_profiles_recommendation(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "profiles/%s/recommendation", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "profiles/%s/recommendation", ticker);
 }
 
 AxionResponse* axion_profiles_statistics(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "profiles/%s/statistics", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "profiles/%s/statistics", ticker);
 }
 
 AxionResponse* axion_profiles_summary(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "profiles/%s/summary", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "profiles/%s/summary", ticker);
 }
 
 AxionResponse* axion_profiles_calendar(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "profiles/%s/calendar", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "profiles/%s/calendar", ticker);
 }
 
 AxionResponse* axion_profiles_info(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "profiles/%s/info", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "profiles/%s/info", ticker);
 }
 
 // =====================================================================
 // EARNINGS API
 // =====================================================================
 AxionResponse* axion_earnings_history(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "earnings/%s/history", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "earnings/%s/history", ticker);
 }
 
 AxionResponse* axion_earnings_trend(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "earnings/%s/trend", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "earnings/%s/trend", ticker);
 }
 
 AxionResponse* axion_earnings_index(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "earnings/%s/index", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "earnings/%s/index", ticker);
 }
 
 AxionResponse* axion_earnings_report(AxionClient *client, const char *ticker, const char *year, const char *quarter) {
     const char *keys[] = {"year", "quarter"};
     const char *values[] = {year, quarter};
     char *query = _build_query(keys, values, 2);
-    char path[256];
-    snprintf(path, sizeof(path), "earnings/%s/report", ticker);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "earnings/%s/report", ticker);
     free(query);
     return resp;
 }
 
 AxionResponse* axion_earnings_transcript_sentiment(AxionClient *client, const char *id) {
     char *q = _build_query((const char*[]){"id"}, (const char*[]){id}, 1);
-    AxionResponse *resp = _axion_request(client, "earnings/transcript/sentiment", q);
+    AxionResponse *resp = _axion_requestf(client, q, "earnings/transcript/sentiment");
     free(q);
     return resp;
 }
@@ -1038,9 +1554,7 @@ AxionResponse* axion_earnings_transcript(AxionClient *client, const char *ticker
     const char *keys[] = {"year", "quarter"};
     const char *values[] = {year, quarter};
     char *query = _build_query(keys, values, 2);
-    char path[256];
-    snprintf(path, sizeof(path), "earnings/%s/transcript", ticker);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "earnings/%s/transcript", ticker);
     free(query);
     return resp;
 }
@@ -1063,9 +1577,7 @@ AxionResponse* axion_filings_recent(AxionClient *client, const char *ticker, con
         values[count++] = limit_str;
     }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    char path[256];
-    snprintf(path, sizeof(path), "filings/%s", ticker);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "filings/%s", ticker);
     free(query);
     return resp;
 }
@@ -1078,15 +1590,13 @@ AxionResponse* axion_filings_history(AxionClient *client, const char *ticker, co
     if (start_date) { keys[count] = "startDate"; values[count++] = start_date; }
     if (end_date)   { keys[count] = "endDate";   values[count++] = end_date; }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    char path[256];
-    snprintf(path, sizeof(path), "filings/%s/%s", ticker, form_type);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "filings/%s/%s", ticker, form_type);
     free(query);
     return resp;
 }
 
 AxionResponse* axion_filings_list_forms(AxionClient *client) {
-    return _axion_request(client, "filings/list/forms", NULL);
+    return _axion_requestf(client, NULL, "filings/list/forms");
 }
 
 AxionResponse* axion_filings_search(AxionClient *client,
@@ -1100,21 +1610,21 @@ AxionResponse* axion_filings_search(AxionClient *client,
     if (year)    { keys[count] = "year";    values[count++] = year; }
     if (quarter) { keys[count] = "quarter"; values[count++] = quarter; }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    AxionResponse *resp = _axion_request(client, "filings/search", query);
+    AxionResponse *resp = _axion_requestf(client, query, "filings/search");
     free(query);
     return resp;
 }
 
 AxionResponse* axion_filings_document_text(AxionClient *client, const char *document_id) {
     char *q = _build_query((const char*[]){"documentId"}, (const char*[]){document_id}, 1);
-    AxionResponse *resp = _axion_request(client, "filings/document/text", q);
+    AxionResponse *resp = _axion_requestf(client, q, "filings/document/text");
     free(q);
     return resp;
 }
 
 AxionResponse* axion_filings_document_sentiment(AxionClient *client, const char *document_id) {
     char *q = _build_query((const char*[]){"documentId"}, (const char*[]){document_id}, 1);
-    AxionResponse *resp = _axion_request(client, "filings/document/sentiment", q);
+    AxionResponse *resp = _axion_requestf(client, q, "filings/document/sentiment");
     free(q);
     return resp;
 }
@@ -1123,13 +1633,12 @@ AxionResponse* axion_filings_document_sentiment(AxionClient *client, const char
 // FINANCIALS API
 // =====================================================================
 static AxionResponse* _financials_request(AxionClient *client, const char *ticker, const char *subpath, int periods) {
-    char path[512];
+    char query[32];
     if (periods > 0) {
-        snprintf(path, sizeof(path), "financials/%s/%s?periods=%d", ticker, subpath, periods);
-        return _axion_request(client, path, NULL);
+        snprintf(query, sizeof(query), "periods=%d", periods);
+        return _axion_requestf(client, query, "financials/%s/%s", ticker, subpath);
     } else {
-        snprintf(path, sizeof(path), "financials/%s/%s", ticker, subpath);
-        return _axion_request(client, path, NULL);
+        return _axion_requestf(client, NULL, "financials/%s/%s", ticker, subpath);
     }
 }
 
@@ -1182,15 +1691,11 @@ AxionResponse* axion_financials_shares_outstanding_diluted(AxionClient *client,
 }
 
 AxionResponse* axion_financials_metrics(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "financials/%s/metrics", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "financials/%s/metrics", ticker);
 }
 
 AxionResponse* axion_financials_snapshot(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "financials/%s/snapshot", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "financials/%s/snapshot", ticker);
 }
 
 static AxionResponse* _financials_statement_request(AxionClient *client, const char *ticker, const char *statement, const char *year, const char *quarter) {
@@ -1200,9 +1705,7 @@ static AxionResponse* _financials_statement_request(AxionClient *client, const c
     if (year)   { keys[count] = "year";   values[count++] = year; }
     if (quarter){ keys[count] = "quarter"; values[count++] = quarter; }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    char path[256];
-    snprintf(path, sizeof(path), "financials/statements/%s/%s", ticker, statement);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "financials/statements/%s/%s", ticker, statement);
     free(query);
     return resp;
 }
@@ -1219,9 +1722,7 @@ static AxionResponse* _financials_historical_request(AxionClient *client, const
     if (to)    { keys[count] = "to";    values[count++] = to; }
     if (frame) { keys[count] = "frame"; values[count++] = frame; }
     char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
-    char path[256];
-    snprintf(path, sizeof(path), "financials/%s/%s", ticker, subpath);
-    AxionResponse *resp = _axion_request(client, path, query);
+    AxionResponse *resp = _axion_requestf(client, query, "financials/%s/%s", ticker, subpath);
     free(query);
     return resp;
 }
@@ -1266,46 +1767,32 @@ AxionResponse* axion_financials_cash_flow_statement(AxionClient *client, const c
 // INSIDERS API
 // =====================================================================
 AxionResponse* axion_insiders_funds(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "insiders/%s/funds", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "insiders/%s/funds", ticker);
 }
 
 AxionResponse* axion_insiders_individuals(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "insiders/%s/individuals", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "insiders/%s/individuals", ticker);
 }
 
 AxionResponse* axion_insiders_institutions(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "insiders/%s/institutions", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "insiders/%s/institutions", ticker);
 }
 
 AxionResponse* axion_insiders_ownership(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "insiders/%s/ownership", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "insiders/%s/ownership", ticker);
 }
 
 AxionResponse* axion_insiders_activity(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "insiders/%s/activity", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "insiders/%s/activity", ticker);
 }
 
 AxionResponse* axion_insiders_transactions(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "insiders/%s/transactions", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "insiders/%s/transactions", ticker);
 }
 
 // =====================================================================
 // WEB TRAFFIC API
 // =====================================================================
 AxionResponse* axion_webtraffic_traffic(AxionClient *client, const char *ticker) {
-    char path[256];
-    snprintf(path, sizeof(path), "web-traffic/%s/traffic", ticker);
-    return _axion_request(client, path, NULL);
+    return _axion_requestf(client, NULL, "web-traffic/%s/traffic", ticker);
 }
@@ -0,0 +1,328 @@
+#ifndef AXION_INTERNAL_H
+#define AXION_INTERNAL_H
+
+// Internal declarations shared between the SDK's translation units.
+// Nothing in here is part of the public API.
+
+#include "axion.h"
+#include "cJSON.h"
+#include <curl/curl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+
+#define BASE_URL "https://api.axionquant.com"
+
+#define AXION_DEFAULT_MAX_IN_FLIGHT 16
+#define AXION_DEFAULT_MAX_STREAMS 100
+#define AXION_MAX_IDLE_HANDLES 64
+#define AXION_SIZE_HINT_SLOTS 64
+#define AXION_MAX_SPARE_BUFFERS 8
+#define AXION_MAX_SPARE_BUFFER_SIZE ((size_t)4 * 1024 * 1024)
+#define AXION_MAX_BODY_PRESIZE ((size_t)256 * 1024 * 1024)
+#define AXION_DEFAULT_CACHE_ENTRIES 1024
+#define AXION_DEFAULT_MAX_ATTEMPTS 3
+#define AXION_DEFAULT_RETRY_BASE_MS 100
+#define AXION_DEFAULT_RETRY_MAX_MS 10000
+#define AXION_DEFAULT_CONNECT_TIMEOUT_MS 10000
+#define AXION_DEFAULT_STALL_TIMEOUT_MS 30000
+
+// Reference-counted curl share, outlives any single client
+typedef struct AxionShare {
+    int refcount;
+    CURLSH *handle;
+    pthread_mutex_t locks[CURL_LOCK_DATA_LAST];
+} AxionShare;
+
+// Opaque struct defined in the header
+struct AxionClient {
+    char *api_key;
+    char *base_url;             // Scheme and host without a trailing '/'; NULL for BASE_URL
+    struct curl_slist *headers; // Built once, shared read-only by every transfer
+    int max_in_flight;
+    size_t arena_chunk;         // Non-zero to allocate each response from an arena
+    AxionResponseMode response_mode;
+    int compression;            // Advertise every encoding curl can decode
+    int http2;                  // Prefer HTTP/2 and multiplex batch transfers
+    int max_streams;            // Concurrent streams per HTTP/2 connection
+    int max_attempts;           // Tries per call, including the first
+    int retry_base_ms;          // Backoff ceiling for the first retry, doubled per retry
+    int retry_max_ms;           // Cap on the backoff and on an honoured Retry-After
+    int hedge_ms;               // Duplicate slow quote calls after this long; 0 disables
+    struct AxionLimiter *limiter;   // Request rate buckets, shared with clones
+    struct AxionStats *stats;       // Per-endpoint latency records, shared with clones
+    int connect_timeout_ms;     // 0 leaves curl's own connect timeout
+    int timeout_ms;             // Whole-transfer limit per attempt; 0 for none
+    int stall_timeout_ms;       // Abort after this long below 1 byte/s; 0 for never
+
+    // DNS and TLS session cache shared by every pooled handle, and by every
+    // client cloned from this one. Connections are kept per handle, see pool.c
+    struct AxionShare *share;
+
+    // Idle easy handles, checked out for the duration of one transfer
+    pthread_mutex_t pool_lock;
+    CURL *idle_handles[AXION_MAX_IDLE_HANDLES];
+    int idle_count;
+    CURLM *idle_multi;          // One cached multi handle for the batch engine
+
+    // Body buffers the caller never saw, kept for reuse by later transfers
+    char *spare_buffers[AXION_MAX_SPARE_BUFFERS];
+    size_t spare_capacity[AXION_MAX_SPARE_BUFFERS];
+    int spare_count;
+
+    // Last body size per endpoint, used to reserve the next body up front
+    uint64_t size_hints[AXION_SIZE_HINT_SLOTS];
+
+    // Response cache, shared with clones; NULL until axion_cache_enable()
+    struct AxionCache *cache;
+    int cache_ttl[AXION_FAMILY_COUNT];
+    int conditional;            // Revalidate expired entries with ETag/Last-Modified
+
+    // Transfers in progress, joined by identical calls from other threads
+    int single_flight;
+    pthread_mutex_t flight_lock;
+    struct AxionFlight *flights;
+
+    // Batches being recorded, each by one thread, see batch.c
+    pthread_mutex_t batch_lock;
+    struct AxionBatch *recording;
+};
+
+// Bump allocator backing a response's body and cJSON tree; freed in one go
+typedef struct AxionArena AxionArena;
+
+AxionArena* _axion_arena_new(size_t chunk_size);
+void* _axion_arena_alloc(AxionArena *arena, size_t size);
+void* _axion_arena_extend(AxionArena *arena, void *ptr, size_t old_size, size_t new_size);
+void _axion_arena_release(AxionArena *arena, void *ptr);
+void _axion_arena_free(AxionArena *arena);
+cJSON* _axion_arena_parse(AxionArena *arena, char *value, size_t length, int insitu);
+
+// Body and tree shared read-only by several responses, e.g. cache hits
+typedef struct AxionPayload {
+    int refcount;
+    int http_status;
+    char *data;
+    cJSON *json;
+    char *backing;
+} AxionPayload;
+
+AxionPayload* _axion_payload_retain(AxionPayload *payload);
+void _axion_payload_release(AxionPayload *payload);
+AxionPayload* _axion_payload_adopt(AxionResponse *response);
+void _axion_response_attach(AxionResponse *response, AxionPayload *payload);
+
+// Private state behind every AxionResponse handed to the caller
+typedef struct {
+    AxionResponse pub;
+    AxionArena *arena;      // Owns pub, data and json when set
+    char *backing;          // In-situ body that json's strings point into
+    AxionPayload *payload;  // Owns data and json instead, when set
+    AxionResponseStats stats;
+} AxionResponseImpl;
+
+#define AXION_IMPL(response) ((AxionResponseImpl *)(response))
+
+// Struct to hold the response from curl
+typedef struct {
+    char *memory;
+    size_t size;
+    size_t capacity;
+    AxionArena *arena;  // Body is carved from this arena instead of the heap
+} MemoryStruct;
+
+// Optional consumer of a successful response body, fed as bytes arrive
+// instead of being buffered. write() returns 0 to continue, 1 to stop
+// early without error and -1 on a parse error; finish() returns an error
+// message or NULL once the body is complete. If stop is set, the progress
+// callback aborts the transfer as soon as another thread makes *stop non-zero.
+// A paced sink's write() may block until its consumer catches up, so the
+// client's stall and total timeouts do not apply; the deadline still does.
+typedef struct {
+    int (*write)(void *ctx, const char *data, size_t len);
+    const char* (*finish)(void *ctx);
+    void *ctx;
+    const int *stop;
+    int paced;
+} AxionSink;
+
+// An expired cache entry being revalidated by a conditional request
+typedef struct {
+    AxionPayload *payload;  // Reused as the response if the server answers 304
+    char *etag;
+    char *last_modified;
+} AxionValidators;
+
+// Deadline and cancel token in force on the thread that starts a call
+typedef struct {
+    long deadline_ms;           // Monotonic ms, see _axion_now_ms; 0 for none
+    AxionCancelToken *cancel;
+} AxionCallLimits;
+
+// State for a single HTTP transfer, shared by the blocking and batch paths
+typedef struct {
+    AxionClient *client;
+    AxionResponse *response;
+    uint32_t endpoint;      // Key for the body size hint, see _axion_endpoint_key
+    const char *name;       // Endpoint template the stats are filed under
+    AxionEndpointFamily family;
+    int64_t started_us;     // When the call's first attempt was set up
+    MemoryStruct chunk;
+    CURL *curl;
+    AxionResponseMode mode;
+    const AxionSink *sink;  // NULL to buffer the body and parse it with cJSON
+    int sink_status;        // Last non-zero value returned by sink->write
+    size_t decoded_bytes;   // Body bytes delivered by curl after decompression
+
+    AxionValidators revalidate;     // Sent as If-None-Match / If-Modified-Since
+    struct curl_slist *headers;     // Client headers plus the conditions, if any
+    char *etag;                     // Validators received with the response
+    char *last_modified;
+
+    AxionCallLimits limits;
+    const char *abort_reason;       // Why the transfer was stopped early, if it was
+} AxionTransfer;
+
+typedef struct AxionLimiter AxionLimiter;
+
+AxionLimiter* _axion_limiter_new(void);
+AxionLimiter* _axion_limiter_retain(AxionLimiter *limiter);
+void _axion_limiter_release(AxionLimiter *limiter);
+long _axion_limiter_reserve(AxionLimiter *limiter, AxionEndpointFamily family);
+void _axion_limiter_refund(AxionLimiter *limiter, AxionEndpointFamily family);
+
+long _axion_now_ms(void);
+void _axion_sleep_ms(long ms);
+long _axion_retry_delay(AxionClient *client, CURL *curl, const AxionTransfer *transfer, CURLcode res, int attempt);
+void _axion_retry_reset(AxionTransfer *transfer);
+CURLcode _axion_perform(AxionClient *client, CURL **curl, AxionTransfer *transfer, const char *url,
+                        AxionEndpointFamily family);
+
+void _axion_call_limits(AxionCallLimits *limits);
+void _axion_call_limits_adopt(const AxionCallLimits *limits);
+const char* _axion_call_expired(const AxionCallLimits *limits);
+long _axion_call_remaining(const AxionCallLimits *limits);
+const char* _axion_call_pause(const AxionCallLimits *limits, long ms);
+long _axion_call_timeout(const AxionClient *client, const AxionTransfer *transfer);
+int _axion_progress(void *userp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
+
+typedef struct AxionStats AxionStats;
+
+int64_t _axion_now_us(void);
+AxionStats* _axion_stats_new(void);
+AxionStats* _axion_stats_retain(AxionStats *stats);
+void _axion_stats_release(AxionStats *stats);
+void _axion_stats_record(AxionClient *client, const AxionTransfer *transfer);
+
+typedef struct AxionFlight AxionFlight;
+
+void _axion_flight_init(AxionClient *client);
+void _axion_flight_cleanup(AxionClient *client);
+AxionFlight* _axion_flight_join(AxionClient *client, const char *url, int *leader);
+void _axion_flight_land(AxionClient *client, AxionFlight *flight, AxionResponse *response, int abandoned);
+AxionResponse* _axion_flight_wait(AxionClient *client, AxionFlight *flight, int *rejoin);
+
+int _axion_global_acquire(void);
+void _axion_global_release(void);
+
+AxionShare* _axion_share_new(void);
+AxionShare* _axion_share_retain(AxionShare *share);
+void _axion_share_release(AxionShare *share);
+
+void _axion_pool_init(AxionClient *client);
+void _axion_pool_cleanup(AxionClient *client);
+CURL* _axion_handle_acquire(AxionClient *client);
+void _axion_handle_release(AxionClient *client, CURL *curl);
+CURLM* _axion_multi_acquire(AxionClient *client);
+void _axion_multi_release(AxionClient *client, CURLM *multi);
+char* _axion_buffer_acquire(AxionClient *client, size_t *capacity);
+void _axion_buffer_release(AxionClient *client, char *buffer, size_t capacity);
+
+AxionResponse* _axion_response_new(AxionClient *client);
+void _axion_body_free(MemoryStruct *mem);
+int _axion_build_url(const AxionClient *client, char *buf, size_t size, const char *path,
+                     const char *query_params);
+int _axion_transfer_setup(AxionClient *client, CURL *curl, AxionTransfer *transfer, const char *url);
+void _axion_transfer_finish(CURL *curl, AxionTransfer *transfer, CURLcode res);
+
+// Incremental JSON scanner that turns price bars into AxionBar callbacks
+#define AXION_STREAM_MAX_DEPTH 64
+
+// List items an iterator may hold unread before its download pauses
+#define AXION_ITER_PREFETCH_BYTES ((size_t)1024 * 1024)
+
+typedef enum {
+    AXION_LEX_NONE,
+    AXION_LEX_STRING,
+    AXION_LEX_STRING_ESCAPE,
+    AXION_LEX_STRING_UNICODE,
+    AXION_LEX_NUMBER,
+    AXION_LEX_LITERAL
+} AxionLexState;
+
+// Fields collected so far for the object open at one nesting level
+typedef struct {
+    unsigned fields;
+    int64_t timestamp;
+    double values[5];
+    char date[64];
+} AxionBarAccum;
+
+typedef struct {
+    AxionBarCallback on_bar;
+    void *userdata;
+    const char *error;
+    size_t bars;
+
+    int depth;
+    char stack[AXION_STREAM_MAX_DEPTH];
+    AxionBarAccum acc[AXION_STREAM_MAX_DEPTH];
+    int expect_key;
+    int key_field;
+
+    AxionLexState lex;
+    char token[64];
+    size_t token_len;
+    int token_overflow;
+    unsigned ucode;
+    int uhex;
+} AxionBarStream;
+
+void _axion_bar_stream_init(AxionBarStream *stream, AxionBarCallback on_bar, void *userdata);
+int _axion_bar_stream_write(void *ctx, const char *data, size_t len);
+const char* _axion_bar_stream_finish(void *ctx);
+int _axion_parse_timestamp(const char *s, int64_t *out);
+double _axion_parse_double(const char *token);
+double _axion_json_number(const cJSON *item);
+int64_t _axion_epoch_seconds(double t);
+AxionResponse* _axion_prices_sink(AxionClient *client, const char *market, const char *ticker,
+                                  const char *from_date, const char *to_date, const char *frame,
+                                  const AxionSink *sink);
+
+AxionResponse* _axion_vrequest(AxionClient *client, const char *query_params, const AxionSink *sink,
+                               const char *fmt, va_list ap);
+AxionResponse* _axion_request_sink(AxionClient *client, const char *query_params, const AxionSink *sink,
+                                   const char *fmt, ...);
+char* _build_query(const char **keys, const char **values, int count);
+
+// Response cache keyed by full URL, see cache.c
+typedef struct AxionCache AxionCache;
+
+AxionEndpointFamily _axion_endpoint_family(const char *fmt);
+AxionCache* _axion_cache_retain(AxionCache *cache);
+void _axion_cache_release(AxionCache *cache);
+AxionPayload* _axion_cache_get(AxionClient *client, AxionEndpointFamily family, const char *url,
+                               AxionValidators *stale);
+void _axion_cache_complete(AxionClient *client, AxionEndpointFamily family, const char *url,
+                           AxionTransfer *transfer);
+void _axion_validators_clear(AxionValidators *validators);
+
+void _axion_batch_init(AxionClient *client);
+void _axion_batch_cleanup(AxionClient *client);
+
+// Batch engine hook: returns a pending response if the calling thread is
+// recording a batch for this client, NULL otherwise.
+AxionResponse* _axion_batch_capture(AxionClient *client, uint32_t endpoint, const char *name,
+                                    AxionEndpointFamily family, const char *url);
+
+#endif // AXION_INTERNAL_H
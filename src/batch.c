@@ -0,0 +1,374 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// One queued endpoint call
+typedef struct {
+    char *url;
+    uint32_t endpoint;
+    char name[AXION_ENDPOINT_NAME_MAX];
+    AxionEndpointFamily family;
+    AxionResponse *response;
+} AxionBatchEntry;
+
+// One in-flight transfer slot; the easy handle is reused across entries
+typedef struct {
+    CURL *curl;
+    AxionTransfer transfer;
+    size_t index;
+    int attempt;            // Attempts finished for the current entry
+    long retry_at;          // Monotonic ms when a backed-off retry is due; 0 if none
+} AxionBatchSlot;
+
+struct AxionBatch {
+    AxionClient *client;
+    AxionBatchEntry *entries;
+    size_t count;
+    size_t capacity;
+    int performed;
+    pthread_t thread;           // The thread whose calls are being queued
+    AxionBatch *next;           // Next batch recording with the same client
+};
+
+// Recording batches hang off their client rather than a thread-local, so a
+// batch can be performed or freed on any thread without leaving the thread
+// that began it pointing at freed memory.
+
+void _axion_batch_init(AxionClient *client) {
+    pthread_mutex_init(&client->batch_lock, NULL);
+    client->recording = NULL;
+}
+
+void _axion_batch_cleanup(AxionClient *client) {
+    pthread_mutex_destroy(&client->batch_lock);
+}
+
+// Finds the batch the calling thread is recording; call with batch_lock held
+static AxionBatch* _recording_batch(AxionClient *client) {
+    pthread_t self = pthread_self();
+    AxionBatch *batch;
+    for (batch = client->recording; batch; batch = batch->next) {
+        if (pthread_equal(batch->thread, self)) return batch;
+    }
+    return NULL;
+}
+
+// Stops a batch from recording, if it still is, from whichever thread
+static void _stop_recording(AxionBatch *batch) {
+    AxionClient *client = batch->client;
+    pthread_mutex_lock(&client->batch_lock);
+    AxionBatch **link = &client->recording;
+    while (*link && *link != batch) link = &(*link)->next;
+    if (*link) __atomic_store_n(link, batch->next, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&client->batch_lock);
+}
+
+static AxionResponse* _batch_append(AxionBatch *batch, uint32_t endpoint, const char *name,
+                                    AxionEndpointFamily family, const char *url) {
+    AxionClient *client = batch->client;
+    if (batch->count == batch->capacity) {
+        size_t capacity = batch->capacity ? batch->capacity * 2 : 64;
+        AxionBatchEntry *entries = realloc(batch->entries, capacity * sizeof(AxionBatchEntry));
+        if (!entries) {
+            fprintf(stderr, "error: failed to grow batch.\n");
+            return NULL;
+        }
+        batch->entries = entries;
+        batch->capacity = capacity;
+    }
+
+    AxionResponse *response = _axion_response_new(client);
+    if (!response) return NULL;
+
+    AxionBatchEntry *entry = &batch->entries[batch->count];
+    entry->url = strdup(url);
+    entry->endpoint = endpoint;
+    snprintf(entry->name, sizeof(entry->name), "%s", name);
+    entry->family = family;
+    entry->response = response;
+    if (!entry->url) {
+        axion_response(response);
+        return NULL;
+    }
+    batch->count++;
+    return response;
+}
+
+AxionResponse* _axion_batch_capture(AxionClient *client, uint32_t endpoint, const char *name,
+                                    AxionEndpointFamily family, const char *url) {
+    // Nearly every call is made with no batch recording, and skips the lock
+    if (!__atomic_load_n(&client->recording, __ATOMIC_ACQUIRE)) return NULL;
+
+    pthread_mutex_lock(&client->batch_lock);
+    AxionBatch *batch = _recording_batch(client);
+    AxionResponse *response = batch ? _batch_append(batch, endpoint, name, family, url) : NULL;
+    pthread_mutex_unlock(&client->batch_lock);
+    return response;
+}
+
+AxionBatch* axion_batch_begin(AxionClient *client) {
+    if (!client) return NULL;
+
+    AxionBatch *batch = calloc(1, sizeof(AxionBatch));
+    if (!batch) {
+        fprintf(stderr, "error: failed to allocate memory for batch.\n");
+        return NULL;
+    }
+    batch->client = client;
+    batch->thread = pthread_self();
+
+    pthread_mutex_lock(&client->batch_lock);
+    int busy = _recording_batch(client) != NULL;
+    if (!busy) {
+        batch->next = client->recording;
+        __atomic_store_n(&client->recording, batch, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&client->batch_lock);
+
+    if (busy) {
+        fprintf(stderr, "error: a batch is already recording on this thread.\n");
+        free(batch);
+        return NULL;
+    }
+    return batch;
+}
+
+size_t axion_batch_size(const AxionBatch *batch) {
+    return batch ? batch->count : 0;
+}
+
+AxionResponse* axion_batch_response(AxionBatch *batch, size_t index) {
+    if (!batch || index >= batch->count) return NULL;
+    return batch->entries[index].response;
+}
+
+// Releases a prepared transfer that curl_multi_add_handle() refused
+static void _batch_unschedule(AxionBatchSlot *slot, const char *reason) {
+    _axion_body_free(&slot->transfer.chunk);
+    if (slot->transfer.headers) curl_slist_free_all(slot->transfer.headers);
+    slot->transfer.headers = NULL;
+    _axion_validators_clear(&slot->transfer.revalidate);
+    slot->transfer.response->error = strdup(reason);
+}
+
+// Starts the next queued entry on a free slot; returns 1 if the cache
+// answered it instead, 0 if it was started and -1 on failure
+static int _batch_start(AxionBatch *batch, CURLM *multi, AxionBatchSlot *slot, size_t index) {
+    AxionBatchEntry *entry = &batch->entries[index];
+    AxionPayload *cached = _axion_cache_get(batch->client, entry->family, entry->url, &slot->transfer.revalidate);
+    if (cached) {
+        _axion_response_attach(entry->response, cached);
+        return 1;
+    }
+
+    AxionCallLimits limits;
+    _axion_call_limits(&limits);
+    const char *reason = _axion_call_expired(&limits);
+    if (reason) {
+        entry->response->error = strdup(reason);
+        _axion_validators_clear(&slot->transfer.revalidate);
+        return -1;
+    }
+
+    slot->index = index;
+    slot->attempt = 0;
+    slot->retry_at = 0;
+    slot->transfer.response = entry->response;
+    slot->transfer.endpoint = entry->endpoint;
+    slot->transfer.name = entry->name;
+    slot->transfer.family = entry->family;
+    slot->transfer.started_us = 0;
+    slot->transfer.sink = NULL;
+
+    if (_axion_transfer_setup(batch->client, slot->curl, &slot->transfer, entry->url) != 0) {
+        entry->response->error = strdup("Failed to allocate response buffer.");
+        _axion_validators_clear(&slot->transfer.revalidate);
+        return -1;
+    }
+    curl_easy_setopt(slot->curl, CURLOPT_PRIVATE, (void *)slot);
+    // Wait for a stream on a connection still negotiating HTTP/2 rather than
+    // opening another; plain http:// never multiplexes, so it never waits
+    if (batch->client->http2 && strncmp(entry->url, "https://", 8) == 0) {
+        curl_easy_setopt(slot->curl, CURLOPT_PIPEWAIT, 1L);
+    }
+    // Over the rate limit, the slot waits for its turn like a backed-off retry,
+    // unless its turn comes too late for the deadline
+    long wait = _axion_limiter_reserve(batch->client->limiter, entry->family);
+    long remaining = _axion_call_remaining(&slot->transfer.limits);
+    if (remaining >= 0 && wait >= remaining) {
+        _axion_limiter_refund(batch->client->limiter, entry->family);
+        _batch_unschedule(slot, "Deadline exceeded.");
+        return -1;
+    }
+    if (wait > 0) {
+        slot->retry_at = _axion_now_ms() + wait;
+        return 0;
+    }
+    if (curl_multi_add_handle(multi, slot->curl) != CURLM_OK) {
+        _batch_unschedule(slot, "Failed to schedule transfer.");
+        return -1;
+    }
+    return 0;
+}
+
+int axion_batch_perform(AxionBatch *batch, AxionBatchCallback on_complete, void *userdata) {
+    if (!batch) return -1;
+    _stop_recording(batch);
+    if (batch->performed) {
+        fprintf(stderr, "error: batch has already been performed.\n");
+        return -1;
+    }
+    batch->performed = 1;
+    if (batch->count == 0) return 0;
+
+    AxionClient *client = batch->client;
+    CURLM *multi = _axion_multi_acquire(client);
+    if (!multi) return -1;
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, client->http2 ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+    curl_multi_setopt(multi, CURLMOPT_MAX_CONCURRENT_STREAMS, (long)client->max_streams);
+
+    size_t nslots = (size_t)client->max_in_flight;
+    if (nslots > batch->count) nslots = batch->count;
+    AxionBatchSlot *slots = calloc(nslots, sizeof(AxionBatchSlot));
+    AxionBatchSlot **idle = malloc(nslots * sizeof(AxionBatchSlot *));
+    if (!slots || !idle) {
+        free(slots);
+        free(idle);
+        _axion_multi_release(client, multi);
+        fprintf(stderr, "error: failed to allocate batch slots.\n");
+        return -1;
+    }
+
+    size_t nidle = 0;
+    size_t i;
+    for (i = 0; i < nslots; i++) {
+        slots[i].curl = _axion_handle_acquire(client);
+        if (slots[i].curl) idle[nidle++] = &slots[i];
+    }
+    if (nidle == 0) {
+        free(slots);
+        free(idle);
+        _axion_multi_release(client, multi);
+        return -1;
+    }
+
+    size_t next = 0;
+    size_t active = 0;
+    size_t failed = 0;
+    while (next < batch->count || active > 0) {
+        // Keep up to max_in_flight transfers running
+        while (nidle > 0 && next < batch->count) {
+            AxionBatchSlot *slot = idle[--nidle];
+            size_t index = next++;
+            int rc = _batch_start(batch, multi, slot, index);
+            if (rc == 0) {
+                active++;
+            } else {
+                idle[nidle++] = slot;
+                if (rc < 0) failed++;
+                if (on_complete) on_complete(batch->entries[index].response, index, userdata);
+            }
+        }
+
+        // Put back transfers whose backoff or rate-limit wait has run out. Each
+        // waiting slot holds a reservation, returned if it is never sent.
+        long now = _axion_now_ms();
+        long next_retry = 0;
+        for (i = 0; i < nslots; i++) {
+            AxionBatchSlot *slot = &slots[i];
+            if (slot->retry_at == 0) continue;
+            const char *reason = _axion_call_expired(&slot->transfer.limits);
+            if (reason) {
+                _axion_limiter_refund(client->limiter, batch->entries[slot->index].family);
+            } else if (slot->retry_at > now) {
+                if (next_retry == 0 || slot->retry_at < next_retry) next_retry = slot->retry_at;
+                continue;
+            } else {
+                curl_easy_setopt(slot->curl, CURLOPT_TIMEOUT_MS, _axion_call_timeout(client, &slot->transfer));
+                slot->retry_at = 0;
+                if (curl_multi_add_handle(multi, slot->curl) == CURLM_OK) continue;
+                reason = "Failed to schedule transfer.";
+            }
+            slot->retry_at = 0;
+            _batch_unschedule(slot, reason);
+            failed++;
+            if (on_complete) on_complete(slot->transfer.response, slot->index, userdata);
+            idle[nidle++] = slot;
+            active--;
+        }
+
+        int still_running = 0;
+        curl_multi_perform(multi, &still_running);
+
+        CURLMsg *msg;
+        int queued;
+        while ((msg = curl_multi_info_read(multi, &queued))) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            CURL *curl = msg->easy_handle;
+            CURLcode res = msg->data.result;
+            AxionBatchSlot *slot = NULL;
+            curl_easy_getinfo(curl, CURLINFO_PRIVATE, (char **)&slot);
+            curl_multi_remove_handle(multi, curl);
+
+            // A retryable failure keeps its slot and runs again after its backoff
+            long delay = _axion_retry_delay(client, curl, &slot->transfer, res, ++slot->attempt);
+            long remaining = _axion_call_remaining(&slot->transfer.limits);
+            if (_axion_call_expired(&slot->transfer.limits) || (remaining >= 0 && delay >= remaining)) delay = -1;
+            if (delay >= 0) {
+                AxionEndpointFamily family = batch->entries[slot->index].family;
+                long wait = _axion_limiter_reserve(client->limiter, family);
+                if (wait > delay) delay = wait;
+                if (remaining >= 0 && delay >= remaining) {
+                    _axion_limiter_refund(client->limiter, family);
+                    delay = -1;
+                }
+            }
+            if (delay >= 0) {
+                _axion_retry_reset(&slot->transfer);
+                slot->retry_at = _axion_now_ms() + (delay > 0 ? delay : 1);
+                if (next_retry == 0 || slot->retry_at < next_retry) next_retry = slot->retry_at;
+                continue;
+            }
+
+            _axion_transfer_finish(curl, &slot->transfer, res);
+            AxionBatchEntry *entry = &batch->entries[slot->index];
+            _axion_cache_complete(client, entry->family, entry->url, &slot->transfer);
+            if (slot->transfer.response->error) failed++;
+            if (on_complete) on_complete(slot->transfer.response, slot->index, userdata);
+
+            idle[nidle++] = slot;
+            active--;
+        }
+
+        if (active > 0 && (still_running > 0 || next_retry > 0)) {
+            long timeout = 1000;
+            if (next_retry > 0 && next_retry - _axion_now_ms() < timeout) timeout = next_retry - _axion_now_ms();
+            curl_multi_poll(multi, NULL, 0, timeout > 0 ? (int)timeout : 0, NULL);
+        }
+    }
+
+    for (i = 0; i < nslots; i++) {
+        if (slots[i].curl) _axion_handle_release(client, slots[i].curl);
+    }
+    free(slots);
+    free(idle);
+    _axion_multi_release(client, multi);
+    return (int)failed;
+}
+
+void axion_batch_free(AxionBatch *batch) {
+    if (!batch) return;
+    _stop_recording(batch);
+
+    size_t i;
+    for (i = 0; i < batch->count; i++) {
+        // Responses belong to the caller; only flag the ones that never ran
+        if (!batch->performed && batch->entries[i].response) {
+            batch->entries[i].response->error = strdup("Batch was freed before it was performed.");
+        }
+        free(batch->entries[i].url);
+    }
+    free(batch->entries);
+    free(batch);
+}
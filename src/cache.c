@@ -0,0 +1,501 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------
+// Shared payloads
+// ---------------------------------------------------------------------
+// A payload is a response body and tree that several responses can view
+// at once. Every holder owns one reference; the last release frees it.
+static AxionPayload* _payload_new(void) {
+    AxionPayload *payload = calloc(1, sizeof(AxionPayload));
+    if (payload) payload->refcount = 1;
+    return payload;
+}
+
+AxionPayload* _axion_payload_retain(AxionPayload *payload) {
+    if (payload) __atomic_add_fetch(&payload->refcount, 1, __ATOMIC_RELAXED);
+    return payload;
+}
+
+void _axion_payload_release(AxionPayload *payload) {
+    if (!payload) return;
+    if (__atomic_sub_fetch(&payload->refcount, 1, __ATOMIC_ACQ_REL) != 0) return;
+    if (payload->data) free(payload->data);
+    if (payload->json) cJSON_Delete(payload->json);
+    if (payload->backing) free(payload->backing);
+    free(payload);
+}
+
+// Points a response at a payload, taking over the caller's reference
+void _axion_response_attach(AxionResponse *response, AxionPayload *payload) {
+    AXION_IMPL(response)->payload = payload;
+    response->http_status = payload->http_status;
+    response->data = payload->data;
+    response->json = payload->json;
+}
+
+// Turns a finished response into a shared payload and returns a new
+// reference to it. Heap responses hand their body and tree over; arena
+// responses keep theirs, so the payload gets a heap copy instead.
+AxionPayload* _axion_payload_adopt(AxionResponse *response) {
+    AxionResponseImpl *impl = AXION_IMPL(response);
+    if (impl->payload) return _axion_payload_retain(impl->payload);
+
+    AxionPayload *payload = _payload_new();
+    if (!payload) return NULL;
+    payload->http_status = response->http_status;
+
+    if (!impl->arena) {
+        payload->data = response->data;
+        payload->json = response->json;
+        payload->backing = impl->backing;
+        impl->backing = NULL;
+        impl->payload = _axion_payload_retain(payload);
+        return payload;
+    }
+
+    if (response->data) {
+        payload->data = strdup(response->data);
+        if (!payload->data) goto fail;
+    }
+    if (response->json) {
+        char *text = payload->data ? NULL : cJSON_PrintUnformatted(response->json);
+        payload->json = cJSON_Parse(payload->data ? payload->data : text);
+        free(text);
+        if (!payload->json) goto fail;
+    }
+    return payload;
+
+fail:
+    _axion_payload_release(payload);
+    return NULL;
+}
+
+// ---------------------------------------------------------------------
+// Endpoint families
+// ---------------------------------------------------------------------
+typedef struct {
+    const char *prefix;   // Template must start with this, or NULL
+    const char *suffix;   // Template must end with this, or NULL
+    AxionEndpointFamily family;
+} FamilyRule;
+
+// First match wins, so the live-data suffixes come before the broad prefixes
+static const FamilyRule family_rules[] = {
+    { NULL, "/quote", AXION_FAMILY_QUOTES },
+    { NULL, "/gainers", AXION_FAMILY_QUOTES },
+    { NULL, "/losers", AXION_FAMILY_QUOTES },
+    { NULL, "/prices", AXION_FAMILY_PRICES },
+    { NULL, "/tickers", AXION_FAMILY_REFERENCE },
+    { "stocks/list/", NULL, AXION_FAMILY_REFERENCE },
+    { "etfs/list/", NULL, AXION_FAMILY_REFERENCE },
+    { "crypto/list/", NULL, AXION_FAMILY_REFERENCE },
+    { "forex/list/", NULL, AXION_FAMILY_REFERENCE },
+    { "futures/list/", NULL, AXION_FAMILY_REFERENCE },
+    { "indices/list/", NULL, AXION_FAMILY_REFERENCE },
+    { "filings/list/", NULL, AXION_FAMILY_REFERENCE },
+    { "stocks/%s", "%s", AXION_FAMILY_REFERENCE },
+    { "etfs/%s", "%s", AXION_FAMILY_REFERENCE },
+    { "crypto/%s", "%s", AXION_FAMILY_REFERENCE },
+    { "forex/%s", "%s", AXION_FAMILY_REFERENCE },
+    { "futures/%s", "%s", AXION_FAMILY_REFERENCE },
+    { "indices/%s", "%s", AXION_FAMILY_REFERENCE },
+    { "profiles/", NULL, AXION_FAMILY_PROFILES },
+    { "etfs/", NULL, AXION_FAMILY_PROFILES },
+    { "indices/", NULL, AXION_FAMILY_PROFILES },
+    { "supply-chain/", NULL, AXION_FAMILY_PROFILES },
+    { "insiders/", NULL, AXION_FAMILY_PROFILES },
+    { "esg/", NULL, AXION_FAMILY_PROFILES },
+    { "credit/ratings/", NULL, AXION_FAMILY_PROFILES },
+    { "financials/", NULL, AXION_FAMILY_FUNDAMENTALS },
+    { "earnings/", NULL, AXION_FAMILY_FUNDAMENTALS },
+    { "filings/", NULL, AXION_FAMILY_FUNDAMENTALS },
+    { "news", NULL, AXION_FAMILY_NEWS },
+    { "sentiment/", NULL, AXION_FAMILY_NEWS },
+};
+
+static int _starts_with(const char *s, const char *prefix) {
+    return strncmp(s, prefix, strlen(prefix)) == 0;
+}
+
+static int _ends_with(const char *s, const char *suffix) {
+    size_t n = strlen(s), m = strlen(suffix);
+    return n >= m && strcmp(s + n - m, suffix) == 0;
+}
+
+AxionEndpointFamily _axion_endpoint_family(const char *fmt) {
+    size_t i;
+    for (i = 0; i < sizeof(family_rules) / sizeof(family_rules[0]); i++) {
+        const FamilyRule *rule = &family_rules[i];
+        if (rule->prefix && !_starts_with(fmt, rule->prefix)) continue;
+        if (rule->suffix && !_ends_with(fmt, rule->suffix)) continue;
+        // "stocks/%s" style rules match the bare ticker endpoint only
+        if (rule->prefix && rule->suffix && strlen(fmt) != strlen(rule->prefix)) continue;
+        return rule->family;
+    }
+    return AXION_FAMILY_OTHER;
+}
+
+// ---------------------------------------------------------------------
+// Memory tier: hash table plus LRU list
+// ---------------------------------------------------------------------
+typedef struct AxionCacheEntry {
+    struct AxionCacheEntry *prev;   // LRU list, most recently used first
+    struct AxionCacheEntry *next;
+    struct AxionCacheEntry *chain;  // Next entry in the same bucket
+    uint64_t hash;
+    time_t expires;                 // Monotonic seconds
+    AxionPayload *payload;
+    char *etag;                     // Validators for revalidating once expired
+    char *last_modified;
+    char key[];                     // Full request URL, path and query
+} AxionCacheEntry;
+
+struct AxionCache {
+    int refcount;
+    pthread_mutex_t lock;
+    AxionCacheEntry **buckets;
+    size_t nbuckets;                // Power of two
+    AxionCacheEntry *head;
+    AxionCacheEntry *tail;
+    size_t count;
+    size_t max_entries;
+    char *disk_dir;                 // NULL for a memory-only cache
+};
+
+static uint64_t _hash_key(const char *key) {
+    uint64_t hash = 14695981039346656037ull;
+    while (*key) {
+        hash ^= (unsigned char)*key++;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static time_t _now(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec;
+}
+
+static void _lru_unlink(AxionCache *cache, AxionCacheEntry *entry) {
+    if (entry->prev) entry->prev->next = entry->next; else cache->head = entry->next;
+    if (entry->next) entry->next->prev = entry->prev; else cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void _lru_push_front(AxionCache *cache, AxionCacheEntry *entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head) cache->head->prev = entry;
+    cache->head = entry;
+    if (!cache->tail) cache->tail = entry;
+}
+
+static AxionCacheEntry** _bucket_slot(AxionCache *cache, uint64_t hash, const char *key) {
+    AxionCacheEntry **slot = &cache->buckets[hash & (cache->nbuckets - 1)];
+    while (*slot && ((*slot)->hash != hash || strcmp((*slot)->key, key) != 0)) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+// Unlinks and frees the entry held in *slot
+static void _entry_remove(AxionCache *cache, AxionCacheEntry **slot) {
+    AxionCacheEntry *entry = *slot;
+    *slot = entry->chain;
+    _lru_unlink(cache, entry);
+    _axion_payload_release(entry->payload);
+    free(entry->etag);
+    free(entry->last_modified);
+    free(entry);
+    cache->count--;
+}
+
+static void _entry_insert(AxionCache *cache, uint64_t hash, const char *key, AxionPayload *payload, time_t expires,
+                          const char *etag, const char *last_modified) {
+    AxionCacheEntry **slot = _bucket_slot(cache, hash, key);
+    if (*slot) _entry_remove(cache, slot);
+
+    while (cache->count >= cache->max_entries && cache->tail) {
+        AxionCacheEntry *lru = cache->tail;
+        _entry_remove(cache, _bucket_slot(cache, lru->hash, lru->key));
+    }
+
+    size_t len = strlen(key);
+    AxionCacheEntry *entry = malloc(sizeof(AxionCacheEntry) + len + 1);
+    if (!entry) {
+        _axion_payload_release(payload);
+        return;
+    }
+    memcpy(entry->key, key, len + 1);
+    entry->hash = hash;
+    entry->expires = expires;
+    entry->payload = payload;
+    entry->etag = etag ? strdup(etag) : NULL;
+    entry->last_modified = last_modified ? strdup(last_modified) : NULL;
+    entry->chain = cache->buckets[hash & (cache->nbuckets - 1)];
+    cache->buckets[hash & (cache->nbuckets - 1)] = entry;
+    _lru_push_front(cache, entry);
+    cache->count++;
+}
+
+// ---------------------------------------------------------------------
+// Disk tier: one file per URL holding its expiry, the URL and the body
+// ---------------------------------------------------------------------
+#define DISK_MAGIC "AXIONCACHE 1\n"
+
+static void _disk_path(const AxionCache *cache, uint64_t hash, char *buf, size_t size) {
+    snprintf(buf, size, "%s/%016llx.json", cache->disk_dir, (unsigned long long)hash);
+}
+
+static AxionPayload* _disk_load(AxionCache *cache, uint64_t hash, const char *key, time_t *expires) {
+    char path[1024];
+    _disk_path(cache, hash, path, sizeof(path));
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    AxionPayload *payload = NULL;
+    char header[sizeof(DISK_MAGIC)];
+    long long when = 0;
+    size_t keylen = strlen(key);
+    char *stored = malloc(keylen + 2);
+
+    if (!stored ||
+        fread(header, 1, sizeof(DISK_MAGIC) - 1, f) != sizeof(DISK_MAGIC) - 1 ||
+        memcmp(header, DISK_MAGIC, sizeof(DISK_MAGIC) - 1) != 0 ||
+        fscanf(f, "%lld\n", &when) != 1 || when <= (long long)_now(CLOCK_REALTIME) ||
+        !fgets(stored, (int)keylen + 2, f) || strncmp(stored, key, keylen) != 0 || stored[keylen] != '\n') {
+        goto done;
+    }
+
+    long start = ftell(f);
+    if (start < 0 || fseek(f, 0, SEEK_END) != 0) goto done;
+    long end = ftell(f);
+    if (end < start || fseek(f, start, SEEK_SET) != 0) goto done;
+
+    size_t size = (size_t)(end - start);
+    char *body = malloc(size + 1);
+    if (!body) goto done;
+    if (fread(body, 1, size, f) != size) {
+        free(body);
+        goto done;
+    }
+    body[size] = 0;
+
+    payload = _payload_new();
+    if (!payload) {
+        free(body);
+        goto done;
+    }
+    payload->http_status = 200;
+    payload->data = body;
+    payload->json = cJSON_ParseWithLength(body, size + 1);
+    if (!payload->json) {
+        _axion_payload_release(payload);
+        payload = NULL;
+        goto done;
+    }
+    *expires = (time_t)when;
+
+done:
+    free(stored);
+    fclose(f);
+    return payload;
+}
+
+// Writes to a temporary file and renames it, so readers never see half a body
+static void _disk_store(AxionCache *cache, uint64_t hash, const char *key, const AxionPayload *payload, int ttl) {
+    char *printed = NULL;
+    const char *body = payload->data;
+    if (!body && payload->json) body = printed = cJSON_PrintUnformatted(payload->json);
+    if (!body) return;
+
+    static int counter = 0;
+    char path[1024], tmp[1100];
+    _disk_path(cache, hash, path, sizeof(path));
+    snprintf(tmp, sizeof(tmp), "%s.%ld.%d.tmp", path, (long)getpid(),
+             __atomic_add_fetch(&counter, 1, __ATOMIC_RELAXED));
+
+    FILE *f = fopen(tmp, "wb");
+    if (f) {
+        long long when = (long long)_now(CLOCK_REALTIME) + ttl;
+        int ok = fprintf(f, DISK_MAGIC "%lld\n%s\n", when, key) > 0 &&
+                 fwrite(body, 1, strlen(body), f) == strlen(body);
+        if (fclose(f) != 0) ok = 0;
+        if (!ok || rename(tmp, path) != 0) remove(tmp);
+    }
+    free(printed);
+}
+
+// ---------------------------------------------------------------------
+// Cache lifecycle and lookups
+// ---------------------------------------------------------------------
+AxionCache* _axion_cache_retain(AxionCache *cache) {
+    if (cache) __atomic_add_fetch(&cache->refcount, 1, __ATOMIC_RELAXED);
+    return cache;
+}
+
+static void _cache_clear(AxionCache *cache) {
+    while (cache->tail) {
+        AxionCacheEntry *lru = cache->tail;
+        _entry_remove(cache, _bucket_slot(cache, lru->hash, lru->key));
+    }
+}
+
+void _axion_cache_release(AxionCache *cache) {
+    if (!cache) return;
+    if (__atomic_sub_fetch(&cache->refcount, 1, __ATOMIC_ACQ_REL) != 0) return;
+    _cache_clear(cache);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->buckets);
+    free(cache->disk_dir);
+    free(cache);
+}
+
+// Returns a new reference to the cached payload for url if it is still
+// fresh. Otherwise, with conditional requests on, fills *stale with an
+// expired entry's payload and validators so the caller can revalidate it.
+AxionPayload* _axion_cache_get(AxionClient *client, AxionEndpointFamily family, const char *url,
+                               AxionValidators *stale) {
+    AxionCache *cache = client->cache;
+    memset(stale, 0, sizeof(*stale));
+    if (!cache || (client->cache_ttl[family] <= 0 && !client->conditional)) return NULL;
+
+    uint64_t hash = _hash_key(url);
+    AxionPayload *payload = NULL;
+    time_t now = _now(CLOCK_MONOTONIC);
+
+    pthread_mutex_lock(&cache->lock);
+    AxionCacheEntry **slot = _bucket_slot(cache, hash, url);
+    AxionCacheEntry *entry = *slot;
+    if (entry && entry->expires > now) {
+        _lru_unlink(cache, entry);
+        _lru_push_front(cache, entry);
+        payload = _axion_payload_retain(entry->payload);
+    } else if (entry && client->conditional && (entry->etag || entry->last_modified)) {
+        stale->payload = _axion_payload_retain(entry->payload);
+        stale->etag = entry->etag ? strdup(entry->etag) : NULL;
+        stale->last_modified = entry->last_modified ? strdup(entry->last_modified) : NULL;
+    } else if (entry) {
+        _entry_remove(cache, slot);
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    if (!payload && !stale->payload && cache->disk_dir && client->cache_ttl[family] > 0) {
+        time_t expires;
+        payload = _disk_load(cache, hash, url, &expires);
+        if (payload) {
+            // Promote to memory with whatever lifetime the file had left
+            pthread_mutex_lock(&cache->lock);
+            _entry_insert(cache, hash, url, _axion_payload_retain(payload),
+                          now + (expires - _now(CLOCK_REALTIME)), NULL, NULL);
+            pthread_mutex_unlock(&cache->lock);
+        }
+    }
+    return payload;
+}
+
+void _axion_validators_clear(AxionValidators *validators) {
+    _axion_payload_release(validators->payload);
+    free(validators->etag);
+    free(validators->last_modified);
+    memset(validators, 0, sizeof(*validators));
+}
+
+// Stores a finished transfer's response under url. A 304 answer to a
+// conditional request is first swapped for the stale payload it confirmed,
+// so the caller gets the previous body and tree without a reparse.
+void _axion_cache_complete(AxionClient *client, AxionEndpointFamily family, const char *url,
+                           AxionTransfer *transfer) {
+    AxionCache *cache = client->cache;
+    AxionResponse *response = transfer->response;
+    AxionValidators *stale = &transfer->revalidate;
+    int ttl = client->cache_ttl[family];
+
+    if (response->http_status == 304 && stale->payload && !response->error) {
+        if (!AXION_IMPL(response)->arena && response->data) free(response->data);
+        response->data = NULL;
+        _axion_response_attach(response, _axion_payload_retain(stale->payload));
+
+        // A 304 may omit validators it is not changing
+        if (!transfer->etag && stale->etag) transfer->etag = strdup(stale->etag);
+        if (!transfer->last_modified && stale->last_modified) {
+            transfer->last_modified = strdup(stale->last_modified);
+        }
+    }
+
+    const char *etag = client->conditional ? transfer->etag : NULL;
+    const char *last_modified = client->conditional ? transfer->last_modified : NULL;
+    if (!cache || response->error || response->http_status != 200 ||
+        (ttl <= 0 && !etag && !last_modified)) {
+        goto done;
+    }
+
+    AxionPayload *payload = _axion_payload_adopt(response);
+    if (!payload) goto done;
+
+    uint64_t hash = _hash_key(url);
+    if (cache->disk_dir && ttl > 0) _disk_store(cache, hash, url, payload, ttl);
+
+    pthread_mutex_lock(&cache->lock);
+    _entry_insert(cache, hash, url, payload, _now(CLOCK_MONOTONIC) + ttl, etag, last_modified);
+    pthread_mutex_unlock(&cache->lock);
+
+done:
+    _axion_validators_clear(stale);
+    free(transfer->etag);
+    free(transfer->last_modified);
+    transfer->etag = NULL;
+    transfer->last_modified = NULL;
+}
+
+int axion_cache_enable(AxionClient *client, size_t max_entries, const char *disk_dir) {
+    if (!client) return -1;
+    if (max_entries == 0) max_entries = AXION_DEFAULT_CACHE_ENTRIES;
+
+    AxionCache *cache = calloc(1, sizeof(AxionCache));
+    if (!cache) {
+        fprintf(stderr, "error: failed to allocate memory for cache.\n");
+        return -1;
+    }
+    cache->nbuckets = 16;
+    while (cache->nbuckets < max_entries) cache->nbuckets *= 2;
+    cache->buckets = calloc(cache->nbuckets, sizeof(AxionCacheEntry *));
+    cache->disk_dir = disk_dir ? strdup(disk_dir) : NULL;
+    if (!cache->buckets || (disk_dir && !cache->disk_dir)) {
+        fprintf(stderr, "error: failed to allocate memory for cache.\n");
+        free(cache->buckets);
+        free(cache->disk_dir);
+        free(cache);
+        return -1;
+    }
+    cache->refcount = 1;
+    cache->max_entries = max_entries;
+    pthread_mutex_init(&cache->lock, NULL);
+
+    _axion_cache_release(client->cache);
+    client->cache = cache;
+    return 0;
+}
+
+void axion_cache_set_ttl(AxionClient *client, AxionEndpointFamily family, int ttl_seconds) {
+    if (!client || family < 0 || family >= AXION_FAMILY_COUNT) return;
+    client->cache_ttl[family] = ttl_seconds > 0 ? ttl_seconds : 0;
+}
+
+void axion_set_conditional_requests(AxionClient *client, int enabled) {
+    if (!client) return;
+    client->conditional = enabled ? 1 : 0;
+}
+
+void axion_cache_clear(AxionClient *client) {
+    if (!client || !client->cache) return;
+    pthread_mutex_lock(&client->cache->lock);
+    _cache_clear(client->cache);
+    pthread_mutex_unlock(&client->cache->lock);
+}
@@ -0,0 +1,115 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+// ---------------------------------------------------------------------
+// Deadlines and cancellation
+// ---------------------------------------------------------------------
+// Endpoint functions have fixed signatures, so a deadline or cancel token
+// is set per thread, the same way a batch records per thread, and every
+// transfer started on that thread picks it up. The progress callback
+// checks both while bytes are moving and while the transfer is idle.
+
+struct AxionCancelToken {
+    int cancelled;
+};
+
+static _Thread_local AxionCallLimits thread_limits = { 0, NULL };
+
+AxionCancelToken* axion_cancel_token_new(void) {
+    AxionCancelToken *token = calloc(1, sizeof(AxionCancelToken));
+    if (!token) fprintf(stderr, "error: failed to allocate memory for cancel token.\n");
+    return token;
+}
+
+void axion_cancel(AxionCancelToken *token) {
+    if (token) __atomic_store_n(&token->cancelled, 1, __ATOMIC_RELEASE);
+}
+
+int axion_cancelled(const AxionCancelToken *token) {
+    return token ? __atomic_load_n(&token->cancelled, __ATOMIC_ACQUIRE) : 0;
+}
+
+void axion_cancel_token(AxionCancelToken *token) {
+    free(token);
+}
+
+void axion_set_deadline(int timeout_ms) {
+    thread_limits.deadline_ms = timeout_ms > 0 ? _axion_now_ms() + timeout_ms : 0;
+}
+
+void axion_set_cancel_token(AxionCancelToken *token) {
+    thread_limits.cancel = token;
+}
+
+void _axion_call_limits(AxionCallLimits *limits) {
+    *limits = thread_limits;
+}
+
+// Lets a worker thread act on behalf of the thread that started it
+void _axion_call_limits_adopt(const AxionCallLimits *limits) {
+    thread_limits = *limits;
+}
+
+// Returns why a call may not continue, or NULL while it still may
+const char* _axion_call_expired(const AxionCallLimits *limits) {
+    if (axion_cancelled(limits->cancel)) return "Request cancelled.";
+    if (limits->deadline_ms && _axion_now_ms() >= limits->deadline_ms) return "Deadline exceeded.";
+    return NULL;
+}
+
+// Milliseconds left before the deadline; -1 if there is none
+long _axion_call_remaining(const AxionCallLimits *limits) {
+    if (!limits->deadline_ms) return -1;
+    long left = limits->deadline_ms - _axion_now_ms();
+    return left > 0 ? left : 0;
+}
+
+// Waits ms, returning early with the reason if the call is cancelled or
+// would outlive its deadline
+const char* _axion_call_pause(const AxionCallLimits *limits, long ms) {
+    long remaining = _axion_call_remaining(limits);
+    if (remaining >= 0 && ms >= remaining) return "Deadline exceeded.";
+    long until = _axion_now_ms() + ms;
+    for (;;) {
+        const char *reason = _axion_call_expired(limits);
+        if (reason) return reason;
+        long left = until - _axion_now_ms();
+        if (left <= 0) return NULL;
+        _axion_sleep_ms(left < 50 ? left : 50);
+    }
+}
+
+// CURLOPT_TIMEOUT_MS for the next attempt: the client's limit, tightened
+// to whatever is left of the deadline. A paced sink's consumer sets the
+// speed of its transfer, so only the deadline bounds it.
+long _axion_call_timeout(const AxionClient *client, const AxionTransfer *transfer) {
+    long timeout = (transfer->sink && transfer->sink->paced) ? 0 : client->timeout_ms;
+    long remaining = _axion_call_remaining(&transfer->limits);
+    if (remaining >= 0) {
+        if (remaining < 1) remaining = 1;
+        if (timeout == 0 || remaining < timeout) timeout = remaining;
+    }
+    return timeout;
+}
+
+int _axion_progress(void *userp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow) {
+    (void)dltotal;
+    (void)dlnow;
+    (void)ultotal;
+    (void)ulnow;
+    AxionTransfer *transfer = (AxionTransfer *)userp;
+    transfer->abort_reason = _axion_call_expired(&transfer->limits);
+    if (!transfer->abort_reason && transfer->sink && transfer->sink->stop &&
+        __atomic_load_n(transfer->sink->stop, __ATOMIC_ACQUIRE)) {
+        transfer->abort_reason = "Request cancelled.";
+    }
+    return transfer->abort_reason ? 1 : 0;
+}
+
+void axion_set_timeouts(AxionClient *client, int connect_timeout_ms, int timeout_ms, int stall_timeout_ms) {
+    if (!client) return;
+    client->connect_timeout_ms = connect_timeout_ms >= 0 ? connect_timeout_ms : AXION_DEFAULT_CONNECT_TIMEOUT_MS;
+    client->timeout_ms = timeout_ms >= 0 ? timeout_ms : 0;
+    client->stall_timeout_ms = stall_timeout_ms >= 0 ? stall_timeout_ms : AXION_DEFAULT_STALL_TIMEOUT_MS;
+}
@@ -0,0 +1,187 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------
+// Single-flight
+// ---------------------------------------------------------------------
+// The first caller for a URL becomes the leader and performs the transfer;
+// callers asking for the same URL meanwhile wait on the flight instead of
+// opening their own. When the leader finishes, its body and tree become a
+// shared payload that every waiter's response views. Waiters keep their own
+// deadline and cancel token, and a leader stopped by its own is not
+// followed: its waiters join again, and one of them leads the retry.
+
+struct AxionFlight {
+    struct AxionFlight *next;
+    int refcount;               // Leader plus waiters; guarded by flight_lock
+    int waiters;
+    int done;
+    int abandoned;              // Leader stopped for its own deadline or cancel token
+    pthread_cond_t finished;    // Waits against CLOCK_MONOTONIC, like _axion_now_ms
+    AxionPayload *payload;      // Leader's body and tree, viewed by every waiter
+    int http_status;
+    char *error;
+    char key[];                 // Full request URL, path and query
+};
+
+void _axion_flight_init(AxionClient *client) {
+    pthread_mutex_init(&client->flight_lock, NULL);
+    client->flights = NULL;
+    client->single_flight = 0;
+}
+
+void _axion_flight_cleanup(AxionClient *client) {
+    pthread_mutex_destroy(&client->flight_lock);
+}
+
+// Drops one reference; call with flight_lock held
+static void _flight_unref(AxionFlight *flight) {
+    if (--flight->refcount > 0) return;
+    pthread_cond_destroy(&flight->finished);
+    _axion_payload_release(flight->payload);
+    free(flight->error);
+    free(flight);
+}
+
+// Joins the flight for url, starting one if none is in the air. Sets
+// *leader when the caller must perform the transfer and then call
+// _axion_flight_land(); otherwise the caller calls _axion_flight_wait().
+// Returns NULL, with *leader set, if single-flight is off or out of memory.
+AxionFlight* _axion_flight_join(AxionClient *client, const char *url, int *leader) {
+    *leader = 1;
+    if (!client->single_flight) return NULL;
+
+    pthread_mutex_lock(&client->flight_lock);
+    AxionFlight *flight = client->flights;
+    while (flight && strcmp(flight->key, url) != 0) flight = flight->next;
+    if (flight) {
+        flight->refcount++;
+        flight->waiters++;
+        *leader = 0;
+        pthread_mutex_unlock(&client->flight_lock);
+        return flight;
+    }
+
+    size_t len = strlen(url);
+    flight = calloc(1, sizeof(AxionFlight) + len + 1);
+    if (flight) {
+        memcpy(flight->key, url, len + 1);
+        flight->refcount = 1;
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&flight->finished, &attr);
+        pthread_condattr_destroy(&attr);
+        flight->next = client->flights;
+        client->flights = flight;
+    }
+    pthread_mutex_unlock(&client->flight_lock);
+    return flight;
+}
+
+// Publishes the leader's response to the waiters and leaves the flight.
+// An abandoned response only reflects the leader's own limits, so it is
+// not published; the waiters are told to join again instead.
+void _axion_flight_land(AxionClient *client, AxionFlight *flight, AxionResponse *response, int abandoned) {
+    if (!flight) return;
+
+    // Once unlinked nobody else can join, so the waiter count is final
+    pthread_mutex_lock(&client->flight_lock);
+    AxionFlight **slot = &client->flights;
+    while (*slot != flight) slot = &(*slot)->next;
+    *slot = flight->next;
+    int waiters = flight->waiters;
+    pthread_mutex_unlock(&client->flight_lock);
+
+    // Only pay for sharing when somebody is actually waiting
+    AxionPayload *payload = NULL;
+    char *error = NULL;
+    if (waiters > 0 && response && !abandoned) {
+        payload = _axion_payload_adopt(response);
+        if (response->error) error = strdup(response->error);
+        else if (!payload) error = strdup("Failed to share response.");
+    }
+
+    pthread_mutex_lock(&client->flight_lock);
+    flight->payload = payload;
+    flight->error = error;
+    flight->http_status = response ? response->http_status : 0;
+    flight->abandoned = abandoned;
+    flight->done = 1;
+    pthread_cond_broadcast(&flight->finished);
+    _flight_unref(flight);
+    pthread_mutex_unlock(&client->flight_lock);
+}
+
+// Waits up to ms for the flight to land, or indefinitely if ms < 0; call
+// with flight_lock held
+static void _flight_sleep(AxionClient *client, AxionFlight *flight, long ms) {
+    if (ms < 0) {
+        pthread_cond_wait(&flight->finished, &client->flight_lock);
+        return;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += ms / 1000;
+    ts.tv_nsec += (ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait(&flight->finished, &client->flight_lock, &ts);
+}
+
+// Blocks until the leader lands and returns this caller's own response.
+// Returns NULL with *rejoin set if the leader abandoned the flight.
+AxionResponse* _axion_flight_wait(AxionClient *client, AxionFlight *flight, int *rejoin) {
+    AxionCallLimits limits;
+    _axion_call_limits(&limits);
+    const char *reason = NULL;
+    *rejoin = 0;
+
+    pthread_mutex_lock(&client->flight_lock);
+    while (!flight->done) {
+        reason = _axion_call_expired(&limits);
+        if (reason) break;
+        // The cancel token is polled every 50 ms, as _axion_call_pause does
+        long ms = _axion_call_remaining(&limits);
+        if (limits.cancel && (ms < 0 || ms > 50)) ms = 50;
+        _flight_sleep(client, flight, ms);
+    }
+    if (reason || flight->abandoned) {
+        // The leader may still share with the others; this caller leaves now
+        if (reason) flight->waiters--;
+        else *rejoin = 1;
+        _flight_unref(flight);
+        pthread_mutex_unlock(&client->flight_lock);
+        if (!reason) return NULL;
+
+        AxionResponse *response = _axion_response_new(client);
+        if (response) response->error = strdup(reason);
+        return response;
+    }
+    AxionPayload *payload = _axion_payload_retain(flight->payload);
+    int http_status = flight->http_status;
+    char *error = flight->error ? strdup(flight->error) : NULL;
+    _flight_unref(flight);
+    pthread_mutex_unlock(&client->flight_lock);
+
+    AxionResponse *response = _axion_response_new(client);
+    if (!response) {
+        _axion_payload_release(payload);
+        free(error);
+        return NULL;
+    }
+    if (payload) _axion_response_attach(response, payload);
+    else response->http_status = http_status;
+    response->error = (error || payload) ? error : strdup("Request failed.");
+    return response;
+}
+
+void axion_set_single_flight(AxionClient *client, int enabled) {
+    if (!client) return;
+    client->single_flight = enabled ? 1 : 0;
+}
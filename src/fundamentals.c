@@ -0,0 +1,455 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <math.h>
+#include <pthread.h>
+#include <limits.h>
+
+// ---------------------------------------------------------------------
+// Schemas
+// ---------------------------------------------------------------------
+// Each typed record is described by a table of fields generated from the
+// X-macro lists in axion.h. Keys are compared in a normalized spelling
+// (ASCII letters lowercased, digits kept, everything else dropped), and
+// every field answers to its JSON key and to its member name.
+//
+// On first use each schema gets a perfect hash: a seed is searched for so
+// that all spellings land in distinct slots of a small table. Decoding a
+// key is then one normalize-and-hash pass, one slot and one compare.
+
+#define SCHEMA_KEY_MAX 48       // Longest normalized spelling plus padding; a multiple of 8
+#define SCHEMA_SLOTS_MAX 512    // A power of two
+#define SCHEMA_SEED_TRIES 4096  // Seeds tried per table size before doubling it
+
+typedef enum {
+    FIELD_NUMBER,       // double, NAN when absent
+    FIELD_STRING,       // char[size], empty when absent
+    FIELD_INTEGER       // int, 0 when absent
+} FieldKind;
+
+typedef struct {
+    const char *key;        // JSON key
+    const char *member;     // Struct member name, accepted as well
+    FieldKind kind;
+    size_t offset;
+    size_t size;            // Buffer size of FIELD_STRING members
+} SchemaField;
+
+typedef struct {
+    char name[SCHEMA_KEY_MAX];
+    int field;              // Index into fields, -1 if the slot is empty
+} SchemaSlot;
+
+typedef struct {
+    const SchemaField *fields;
+    size_t count;
+    uint32_t seed;
+    uint32_t mask;
+    SchemaSlot slots[SCHEMA_SLOTS_MAX];
+} Schema;
+
+#define FISCAL_FIELDS(type) \
+    { "date", "fiscal_date", FIELD_STRING, offsetof(type, fiscal.date), sizeof(((type *)0)->fiscal.date) }, \
+    { "period", "fiscal_period", FIELD_STRING, offsetof(type, fiscal.period), sizeof(((type *)0)->fiscal.period) }, \
+    { "fiscalYear", "year", FIELD_INTEGER, offsetof(type, fiscal.year), 0 },
+#define SCHEMA_FIELD(type, member, key) { key, #member, FIELD_NUMBER, offsetof(type, member), 0 },
+
+#define BALANCE_SHEET_FIELD(member, key) SCHEMA_FIELD(AxionBalanceSheet, member, key)
+#define INCOME_STATEMENT_FIELD(member, key) SCHEMA_FIELD(AxionIncomeStatement, member, key)
+#define CASH_FLOW_STATEMENT_FIELD(member, key) SCHEMA_FIELD(AxionCashFlowStatement, member, key)
+#define METRICS_FIELD(member, key) SCHEMA_FIELD(AxionMetrics, member, key)
+#define SNAPSHOT_FIELD(member, key) SCHEMA_FIELD(AxionSnapshot, member, key)
+
+static const SchemaField balance_sheet_fields[] = {
+    FISCAL_FIELDS(AxionBalanceSheet)
+    AXION_BALANCE_SHEET_FIELDS(BALANCE_SHEET_FIELD)
+};
+
+static const SchemaField income_statement_fields[] = {
+    FISCAL_FIELDS(AxionIncomeStatement)
+    AXION_INCOME_STATEMENT_FIELDS(INCOME_STATEMENT_FIELD)
+};
+
+static const SchemaField cash_flow_statement_fields[] = {
+    FISCAL_FIELDS(AxionCashFlowStatement)
+    AXION_CASH_FLOW_STATEMENT_FIELDS(CASH_FLOW_STATEMENT_FIELD)
+};
+
+static const SchemaField metrics_fields[] = {
+    AXION_METRICS_FIELDS(METRICS_FIELD)
+};
+
+static const SchemaField snapshot_fields[] = {
+    AXION_SNAPSHOT_FIELDS(SNAPSHOT_FIELD)
+};
+
+#define SCHEMA(fields) { fields, sizeof(fields) / sizeof(fields[0]), 0, 0, {{{0}, 0}} }
+
+static Schema balance_sheet_schema = SCHEMA(balance_sheet_fields);
+static Schema income_statement_schema = SCHEMA(income_statement_fields);
+static Schema cash_flow_statement_schema = SCHEMA(cash_flow_statement_fields);
+static Schema metrics_schema = SCHEMA(metrics_fields);
+static Schema snapshot_schema = SCHEMA(snapshot_fields);
+
+static pthread_once_t schemas_once = PTHREAD_ONCE_INIT;
+
+// Normalized form of each byte: lowercase letters and digits map to
+// themselves, everything else to 0 and is dropped
+static unsigned char key_chars[256];
+
+static void _key_chars_init(void) {
+    int c;
+    for (c = '0'; c <= '9'; c++) key_chars[c] = (unsigned char)c;
+    for (c = 'a'; c <= 'z'; c++) key_chars[c] = (unsigned char)c;
+    for (c = 'A'; c <= 'Z'; c++) key_chars[c] = (unsigned char)(c - 'A' + 'a');
+}
+
+// Normalizes key into name, zero-padded to a multiple of eight bytes, and
+// hashes it a word at a time. Returns the length of name, or -1 if the key
+// is empty or too long to be a schema key.
+static int _normalize(const char *key, char *name, uint32_t seed, uint32_t *hash) {
+    int len = 0;
+    const unsigned char *p;
+    for (p = (const unsigned char *)key; *p; p++) {
+        unsigned char c = key_chars[*p];
+        if (!c) continue;
+        if (len == SCHEMA_KEY_MAX - 1) return -1;
+        name[len++] = (char)c;
+    }
+    if (len == 0) return -1;
+    memset(name + len, 0, 8 - (len & 7));
+
+    uint64_t h = seed ^ ((uint64_t)len << 32);
+    int i;
+    for (i = 0; i < len; i += 8) {
+        uint64_t word;
+        memcpy(&word, name + i, sizeof(word));
+        h = (h ^ word) * 0x9e3779b97f4a7c15ull;
+        h ^= h >> 29;
+    }
+    *hash = (uint32_t)(h ^ (h >> 32));
+    return len;
+}
+
+// Places every spelling with this seed; fails on the first collision
+static int _schema_place(Schema *schema, uint32_t seed, uint32_t mask) {
+    size_t f, i;
+    for (i = 0; i <= mask; i++) schema->slots[i].field = -1;
+
+    for (f = 0; f < schema->count; f++) {
+        const char *spellings[2] = { schema->fields[f].key, schema->fields[f].member };
+        for (i = 0; i < 2; i++) {
+            char name[SCHEMA_KEY_MAX];
+            uint32_t hash;
+            if (_normalize(spellings[i], name, seed, &hash) < 0) continue;
+            SchemaSlot *slot = &schema->slots[hash & mask];
+            if (slot->field >= 0) {
+                // The same spelling twice (e.g. key and member agree) is no collision
+                if (strcmp(slot->name, name) == 0) continue;
+                return 0;
+            }
+            memcpy(slot->name, name, sizeof(name));
+            slot->field = (int)f;
+        }
+    }
+    schema->seed = seed;
+    schema->mask = mask;
+    return 1;
+}
+
+static void _schema_build(Schema *schema) {
+    uint32_t size = 16, seed;
+    while (size < 4 * schema->count && size < SCHEMA_SLOTS_MAX) size *= 2;
+    for (; size <= SCHEMA_SLOTS_MAX; size *= 2) {
+        for (seed = 1; seed <= SCHEMA_SEED_TRIES; seed++) {
+            if (_schema_place(schema, seed, size - 1)) return;
+        }
+    }
+    // Unreachable for the schemas in axion.h; leave the table empty rather than wrong
+    fprintf(stderr, "error: no perfect hash found for a %zu-field schema.\n", schema->count);
+    for (seed = 0; seed < SCHEMA_SLOTS_MAX; seed++) schema->slots[seed].field = -1;
+    schema->mask = 0;
+}
+
+static void _schemas_init(void) {
+    _key_chars_init();
+    _schema_build(&balance_sheet_schema);
+    _schema_build(&income_statement_schema);
+    _schema_build(&cash_flow_statement_schema);
+    _schema_build(&metrics_schema);
+    _schema_build(&snapshot_schema);
+}
+
+static const Schema* _schema(const Schema *schema) {
+    pthread_once(&schemas_once, _schemas_init);
+    return schema;
+}
+
+static const SchemaField* _schema_find(const Schema *schema, const char *key) {
+    char name[SCHEMA_KEY_MAX];
+    uint32_t hash;
+    if (!key || _normalize(key, name, schema->seed, &hash) < 0) return NULL;
+    const SchemaSlot *slot = &schema->slots[hash & schema->mask];
+    if (slot->field < 0 || strcmp(slot->name, name) != 0) return NULL;
+    return &schema->fields[slot->field];
+}
+
+// ---------------------------------------------------------------------
+// Decoding
+// ---------------------------------------------------------------------
+static void _record_reset(const Schema *schema, void *record) {
+    size_t f;
+    for (f = 0; f < schema->count; f++) {
+        char *member = (char *)record + schema->fields[f].offset;
+        switch (schema->fields[f].kind) {
+        case FIELD_NUMBER:  *(double *)member = NAN; break;
+        case FIELD_STRING:  member[0] = '\0'; break;
+        case FIELD_INTEGER: *(int *)member = 0; break;
+        }
+    }
+}
+
+// One pass over the object's members; keys outside the schema are skipped
+static void _record_decode(const Schema *schema, void *record, const cJSON *obj) {
+    const cJSON *item;
+    for (item = obj->child; item; item = item->next) {
+        const SchemaField *field = _schema_find(schema, item->string);
+        if (!field) continue;
+        char *member = (char *)record + field->offset;
+        switch (field->kind) {
+        case FIELD_NUMBER:
+            *(double *)member = _axion_json_number(item);
+            break;
+        case FIELD_STRING:
+            if (cJSON_IsString(item) && item->valuestring) {
+                size_t len = strnlen(item->valuestring, field->size - 1);
+                memcpy(member, item->valuestring, len);
+                member[len] = '\0';
+            }
+            break;
+        case FIELD_INTEGER: {
+            // Converting a value int cannot hold is undefined, so it stays 0
+            double value = _axion_json_number(item);
+            if (isfinite(value) && value >= INT_MIN && value <= INT_MAX) *(int *)member = (int)value;
+            break;
+        }
+        }
+    }
+}
+
+// Records arrive as one object or an array of them, optionally under "data"
+static const cJSON* _payload(const cJSON *json) {
+    const cJSON *data = cJSON_GetObjectItemCaseSensitive(json, "data");
+    return (cJSON_IsObject(data) || cJSON_IsArray(data)) ? data : json;
+}
+
+// Decodes up to max records into out; returns how many the payload holds
+static int _records_decode(const Schema *schema, const cJSON *json, void *out, size_t size, size_t max) {
+    if (!json) return -1;
+    schema = _schema(schema);
+    const cJSON *payload = _payload(json);
+
+    if (cJSON_IsObject(payload)) {
+        if (max > 0) {
+            _record_reset(schema, out);
+            _record_decode(schema, out, payload);
+        }
+        return 1;
+    }
+    if (!cJSON_IsArray(payload)) return -1;
+
+    size_t count = 0;
+    const cJSON *item;
+    cJSON_ArrayForEach(item, payload) {
+        if (!cJSON_IsObject(item)) continue;
+        if (count < max) {
+            void *record = (char *)out + count * size;
+            _record_reset(schema, record);
+            _record_decode(schema, record, item);
+        }
+        count++;
+    }
+    return (int)count;
+}
+
+// Moves a statement response into a typed list; items is calloc'd to fit
+static void _statements(const Schema *schema, size_t size, AxionResponse *resp,
+                        void **items, size_t *count, int *http_status, char **error) {
+    *http_status = resp->http_status;
+    if (resp->error) {
+        *error = resp->error;
+        resp->error = NULL;
+        return;
+    }
+    int n = _records_decode(schema, resp->json, NULL, size, 0);
+    if (n < 0) {
+        *error = strdup("Response has no statement to decode.");
+        return;
+    }
+    if (n > 0) {
+        *items = calloc((size_t)n, size);
+        if (!*items) {
+            *error = strdup("Failed to allocate memory for statements.");
+            return;
+        }
+        _records_decode(schema, resp->json, *items, size, (size_t)n);
+    }
+    *count = (size_t)n;
+}
+
+// Decodes the first record of a response into a single typed struct
+static void _single(const Schema *schema, AxionResponse *resp, void *record, int *http_status, char **error) {
+    _record_reset(_schema(schema), record);
+    *http_status = resp->http_status;
+    if (resp->error) {
+        *error = resp->error;
+        resp->error = NULL;
+    } else if (_records_decode(schema, resp->json, record, 0, 1) <= 0) {
+        *error = strdup("Response has no object to decode.");
+    }
+}
+
+// ---------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------
+AxionBalanceSheets* axion_financials_balance_sheet_typed(AxionClient *client, const char *ticker, const char *year, const char *quarter) {
+    AxionBalanceSheets *statements = calloc(1, sizeof(AxionBalanceSheets));
+    if (!statements) {
+        fprintf(stderr, "error: failed to allocate memory for statements.\n");
+        return NULL;
+    }
+    AxionResponse *resp = axion_financials_balance_sheet(client, ticker, year, quarter);
+    if (!resp) {
+        free(statements);
+        return NULL;
+    }
+    _statements(&balance_sheet_schema, sizeof(AxionBalanceSheet), resp, (void **)&statements->items,
+                &statements->count, &statements->http_status, &statements->error);
+    axion_response(resp);
+    return statements;
+}
+
+AxionIncomeStatements* axion_financials_income_statement_typed(AxionClient *client, const char *ticker, const char *year, const char *quarter) {
+    AxionIncomeStatements *statements = calloc(1, sizeof(AxionIncomeStatements));
+    if (!statements) {
+        fprintf(stderr, "error: failed to allocate memory for statements.\n");
+        return NULL;
+    }
+    AxionResponse *resp = axion_financials_income_statement(client, ticker, year, quarter);
+    if (!resp) {
+        free(statements);
+        return NULL;
+    }
+    _statements(&income_statement_schema, sizeof(AxionIncomeStatement), resp, (void **)&statements->items,
+                &statements->count, &statements->http_status, &statements->error);
+    axion_response(resp);
+    return statements;
+}
+
+AxionCashFlowStatements* axion_financials_cash_flow_statement_typed(AxionClient *client, const char *ticker, const char *year, const char *quarter) {
+    AxionCashFlowStatements *statements = calloc(1, sizeof(AxionCashFlowStatements));
+    if (!statements) {
+        fprintf(stderr, "error: failed to allocate memory for statements.\n");
+        return NULL;
+    }
+    AxionResponse *resp = axion_financials_cash_flow_statement(client, ticker, year, quarter);
+    if (!resp) {
+        free(statements);
+        return NULL;
+    }
+    _statements(&cash_flow_statement_schema, sizeof(AxionCashFlowStatement), resp, (void **)&statements->items,
+                &statements->count, &statements->http_status, &statements->error);
+    axion_response(resp);
+    return statements;
+}
+
+AxionMetrics* axion_financials_metrics_typed(AxionClient *client, const char *ticker) {
+    AxionMetrics *metrics = calloc(1, sizeof(AxionMetrics));
+    if (!metrics) {
+        fprintf(stderr, "error: failed to allocate memory for metrics.\n");
+        return NULL;
+    }
+    AxionResponse *resp = axion_financials_metrics(client, ticker);
+    if (!resp) {
+        free(metrics);
+        return NULL;
+    }
+    _single(&metrics_schema, resp, metrics, &metrics->http_status, &metrics->error);
+    axion_response(resp);
+    return metrics;
+}
+
+AxionSnapshot* axion_financials_snapshot_typed(AxionClient *client, const char *ticker) {
+    AxionSnapshot *snapshot = calloc(1, sizeof(AxionSnapshot));
+    if (!snapshot) {
+        fprintf(stderr, "error: failed to allocate memory for snapshot.\n");
+        return NULL;
+    }
+    AxionResponse *resp = axion_financials_snapshot(client, ticker);
+    if (!resp) {
+        free(snapshot);
+        return NULL;
+    }
+    _single(&snapshot_schema, resp, snapshot, &snapshot->http_status, &snapshot->error);
+    axion_response(resp);
+    return snapshot;
+}
+
+void axion_balance_sheets(AxionBalanceSheets *statements) {
+    if (!statements) return;
+    free(statements->items);
+    if (statements->error) free(statements->error);
+    free(statements);
+}
+
+void axion_income_statements(AxionIncomeStatements *statements) {
+    if (!statements) return;
+    free(statements->items);
+    if (statements->error) free(statements->error);
+    free(statements);
+}
+
+void axion_cash_flow_statements(AxionCashFlowStatements *statements) {
+    if (!statements) return;
+    free(statements->items);
+    if (statements->error) free(statements->error);
+    free(statements);
+}
+
+void axion_metrics(AxionMetrics *metrics) {
+    if (!metrics) return;
+    if (metrics->error) free(metrics->error);
+    free(metrics);
+}
+
+void axion_snapshot(AxionSnapshot *snapshot) {
+    if (!snapshot) return;
+    if (snapshot->error) free(snapshot->error);
+    free(snapshot);
+}
+
+int axion_decode_balance_sheets(const cJSON *json, AxionBalanceSheet *out, size_t max) {
+    return _records_decode(&balance_sheet_schema, json, out, sizeof(AxionBalanceSheet), out ? max : 0);
+}
+
+int axion_decode_income_statements(const cJSON *json, AxionIncomeStatement *out, size_t max) {
+    return _records_decode(&income_statement_schema, json, out, sizeof(AxionIncomeStatement), out ? max : 0);
+}
+
+int axion_decode_cash_flow_statements(const cJSON *json, AxionCashFlowStatement *out, size_t max) {
+    return _records_decode(&cash_flow_statement_schema, json, out, sizeof(AxionCashFlowStatement), out ? max : 0);
+}
+
+int axion_decode_metrics(const cJSON *json, AxionMetrics *out) {
+    if (!out) return -1;
+    _record_reset(_schema(&metrics_schema), out);
+    return _records_decode(&metrics_schema, json, out, 0, 1) <= 0 ? -1 : 0;
+}
+
+int axion_decode_snapshot(const cJSON *json, AxionSnapshot *out) {
+    if (!out) return -1;
+    _record_reset(_schema(&snapshot_schema), out);
+    return _records_decode(&snapshot_schema, json, out, 0, 1) <= 0 ? -1 : 0;
+}
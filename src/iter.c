@@ -0,0 +1,391 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// ---------------------------------------------------------------------
+// List iterators
+// ---------------------------------------------------------------------
+// A background thread downloads the list and splits its array into one
+// JSON text per item as bytes arrive. Items wait in a queue bounded by
+// size; when it is full the write callback blocks, which stalls the socket
+// read until the caller catches up. Memory therefore stays bounded by the
+// queue and the item being read, however long the list is.
+
+typedef struct AxionIterItem {
+    struct AxionIterItem *next;
+    size_t len;
+    char text[];
+} AxionIterItem;
+
+struct AxionIterator {
+    AxionClient *client;
+    const char *fmt;            // Endpoint path template and its arguments
+    char *args[2];
+    char *query;
+    pthread_t thread;
+    int started;
+    AxionCallLimits limits;     // Deadline and cancel token of the opening thread
+
+    // Queue shared by the download thread and the caller
+    pthread_mutex_t lock;
+    pthread_cond_t ready;       // An item was queued or the download ended
+    pthread_cond_t space;       // An item was taken or the caller gave up
+    AxionIterItem *head;
+    AxionIterItem *tail;
+    size_t queued_bytes;
+    int done;
+    int cancelled;
+    AxionResponse *response;    // Set once done; carries http_status and error
+
+    cJSON *current;             // Item last returned to the caller
+    const char *item_error;     // Set when an item failed to parse; iteration stops there
+
+    // Scanner state, touched only by the download thread
+    int depth;
+    char stack[AXION_STREAM_MAX_DEPTH];
+    int in_string;
+    int escape;
+    int expect_key;             // Next string in the root object is a key
+    int capture_key;
+    char key[16];
+    size_t key_len;
+    int list_depth;             // Depth inside the list array; 0 before, -1 after
+    int in_item;
+    int item_depth;             // Depth the current item started at
+    char *item;
+    size_t item_len;
+    size_t item_cap;
+    const char *error;
+};
+
+static int _item_append(AxionIterator *it, char c) {
+    if (it->item_len == it->item_cap) {
+        size_t cap = it->item_cap ? it->item_cap * 2 : 256;
+        char *grown = realloc(it->item, cap);
+        if (!grown) {
+            it->error = "Failed to allocate memory for list item.";
+            return -1;
+        }
+        it->item = grown;
+        it->item_cap = cap;
+    }
+    it->item[it->item_len++] = c;
+    return 0;
+}
+
+// Queues the finished item; returns 1 if the caller has gone away
+static int _item_emit(AxionIterator *it) {
+    AxionIterItem *entry = malloc(sizeof(AxionIterItem) + it->item_len);
+    if (!entry) {
+        it->error = "Failed to allocate memory for list item.";
+        return -1;
+    }
+    entry->next = NULL;
+    entry->len = it->item_len;
+    memcpy(entry->text, it->item, it->item_len);
+    it->in_item = 0;
+    it->item_len = 0;
+
+    pthread_mutex_lock(&it->lock);
+    // One item is always let through, so an item larger than the queue still moves
+    while (!it->cancelled && it->head && it->queued_bytes + entry->len > AXION_ITER_PREFETCH_BYTES) {
+        pthread_cond_wait(&it->space, &it->lock);
+    }
+    int cancelled = it->cancelled;
+    if (!cancelled) {
+        if (it->tail) it->tail->next = entry; else it->head = entry;
+        it->tail = entry;
+        it->queued_bytes += entry->len;
+        pthread_cond_signal(&it->ready);
+    }
+    pthread_mutex_unlock(&it->lock);
+
+    if (cancelled) {
+        free(entry);
+        return 1;
+    }
+    return 0;
+}
+
+static int _is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// The list is the root array, or the array under the root object's "data" key
+static int _is_list_start(const AxionIterator *it) {
+    if (it->list_depth != 0) return 0;
+    if (it->depth == 0) return 1;
+    return it->depth == 1 && it->stack[0] == '{' && it->key_len == 4 && memcmp(it->key, "data", 4) == 0;
+}
+
+static int _iter_write(void *ctx, const char *data, size_t len) {
+    AxionIterator *it = (AxionIterator *)ctx;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        char c = data[i];
+
+        if (it->in_string) {
+            if (it->in_item && _item_append(it, c) != 0) return -1;
+            if (it->escape) {
+                it->escape = 0;
+            } else if (c == '\\') {
+                it->escape = 1;
+            } else if (c == '"') {
+                it->in_string = 0;
+                it->capture_key = 0;
+            } else if (it->capture_key && it->key_len < sizeof(it->key)) {
+                it->key[it->key_len++] = c;
+            }
+            continue;
+        }
+        if (_is_space(c)) {
+            if (it->in_item && _item_append(it, c) != 0) return -1;
+            continue;
+        }
+
+        int in_list = it->list_depth > 0 && it->depth == it->list_depth;
+
+        // A scalar item ends at the separator or bracket after it
+        if (in_list && it->in_item && (c == ',' || c == ']')) {
+            int rc = _item_emit(it);
+            if (rc != 0) return rc;
+        }
+        if (in_list && !it->in_item && c != ',' && c != ']') {
+            it->in_item = 1;
+            it->item_depth = it->depth;
+        }
+        if (it->in_item && _item_append(it, c) != 0) return -1;
+
+        switch (c) {
+        case '"':
+            it->in_string = 1;
+            if (it->depth == 1 && it->stack[0] == '{' && it->expect_key) {
+                it->capture_key = 1;
+                it->key_len = 0;
+            }
+            break;
+        case ':':
+            if (it->depth == 1) it->expect_key = 0;
+            break;
+        case ',':
+            if (it->depth == 1) it->expect_key = 1;
+            break;
+        case '{':
+        case '[':
+            if (it->depth >= AXION_STREAM_MAX_DEPTH) {
+                it->error = "List item is nested too deeply.";
+                return -1;
+            }
+            if (c == '[' && _is_list_start(it)) it->list_depth = it->depth + 1;
+            it->stack[it->depth++] = c;
+            if (it->depth == 1) it->expect_key = 1;
+            break;
+        case '}':
+        case ']':
+            if (it->depth == 0 || it->stack[it->depth - 1] != (c == '}' ? '{' : '[')) {
+                it->error = "Malformed JSON in list response.";
+                return -1;
+            }
+            it->depth--;
+            if (it->list_depth > 0 && it->depth < it->list_depth) {
+                it->list_depth = -1;
+            } else if (it->in_item && it->depth == it->item_depth) {
+                int rc = _item_emit(it);
+                if (rc != 0) return rc;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return 0;
+}
+
+static const char* _iter_finish(void *ctx) {
+    AxionIterator *it = (AxionIterator *)ctx;
+    if (it->error) return it->error;
+    if (it->depth != 0) return "Malformed JSON in list response (unbalanced brackets).";
+    if (it->list_depth == 0) return "Response does not contain a list.";
+    return NULL;
+}
+
+static void* _iter_run(void *arg) {
+    AxionIterator *it = (AxionIterator *)arg;
+    // The write callback blocks while the queue is full, so the transfer
+    // moves at the caller's pace and is exempt from the stall timeout
+    AxionSink sink = { _iter_write, _iter_finish, it, &it->cancelled, 1 };
+    _axion_call_limits_adopt(&it->limits);
+    AxionResponse *response = _axion_request_sink(it->client, it->query, &sink, it->fmt, it->args[0], it->args[1]);
+
+    pthread_mutex_lock(&it->lock);
+    it->response = response;
+    it->done = 1;
+    pthread_cond_signal(&it->ready);
+    pthread_mutex_unlock(&it->lock);
+    return NULL;
+}
+
+static AxionIterator* _iter_open(AxionClient *client, char *query, const char *fmt, const char *arg0, const char *arg1) {
+    if (!client) {
+        free(query);
+        return NULL;
+    }
+
+    AxionIterator *it = calloc(1, sizeof(AxionIterator));
+    if (!it) {
+        fprintf(stderr, "error: failed to allocate memory for iterator.\n");
+        free(query);
+        return NULL;
+    }
+    it->client = client;
+    it->fmt = fmt;
+    it->query = query;
+    it->args[0] = arg0 ? strdup(arg0) : NULL;
+    it->args[1] = arg1 ? strdup(arg1) : NULL;
+    _axion_call_limits(&it->limits);
+    pthread_mutex_init(&it->lock, NULL);
+    pthread_cond_init(&it->ready, NULL);
+    pthread_cond_init(&it->space, NULL);
+
+    if (pthread_create(&it->thread, NULL, _iter_run, it) != 0) {
+        fprintf(stderr, "error: failed to start iterator thread.\n");
+        axion_iter_free(it);
+        return NULL;
+    }
+    it->started = 1;
+    return it;
+}
+
+struct cJSON* axion_iter_next(AxionIterator *it) {
+    if (!it) return NULL;
+    if (it->current) cJSON_Delete(it->current);
+    it->current = NULL;
+    if (it->item_error) return NULL;
+
+    pthread_mutex_lock(&it->lock);
+    while (!it->head && !it->done) {
+        pthread_cond_wait(&it->ready, &it->lock);
+    }
+    AxionIterItem *entry = it->head;
+    if (entry) {
+        it->head = entry->next;
+        if (!it->head) it->tail = NULL;
+        it->queued_bytes -= entry->len;
+        pthread_cond_signal(&it->space);
+    }
+    pthread_mutex_unlock(&it->lock);
+
+    if (!entry) return NULL;
+    it->current = cJSON_ParseWithLength(entry->text, entry->len);
+    free(entry);
+    if (!it->current) it->item_error = "Failed to parse list item.";
+    return it->current;
+}
+
+const char* axion_iter_error(const AxionIterator *it) {
+    if (!it) return NULL;
+    if (it->item_error) return it->item_error;
+    if (!it->done) return NULL;
+    if (!it->response) return "Request failed.";
+    return it->response->error;
+}
+
+int axion_iter_status(const AxionIterator *it) {
+    if (!it || !it->done || !it->response) return 0;
+    return it->response->http_status;
+}
+
+void axion_iter_free(AxionIterator *it) {
+    if (!it) return;
+
+    // Unblock the download thread; the progress callback also sees the
+    // flag through the sink and aborts a stalled transfer without waiting
+    pthread_mutex_lock(&it->lock);
+    __atomic_store_n(&it->cancelled, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&it->space);
+    pthread_mutex_unlock(&it->lock);
+    if (it->started) pthread_join(it->thread, NULL);
+
+    while (it->head) {
+        AxionIterItem *next = it->head->next;
+        free(it->head);
+        it->head = next;
+    }
+    if (it->current) cJSON_Delete(it->current);
+    if (it->response) axion_response(it->response);
+    pthread_cond_destroy(&it->space);
+    pthread_cond_destroy(&it->ready);
+    pthread_mutex_destroy(&it->lock);
+    free(it->item);
+    free(it->args[0]);
+    free(it->args[1]);
+    free(it->query);
+    free(it);
+}
+
+// ---------------------------------------------------------------------
+// Iterable list endpoints
+// ---------------------------------------------------------------------
+AxionIterator* axion_stocks_tickers_iter(AxionClient *client, const char *country, const char *exchange) {
+    const char *keys[] = {"country", "exchange"};
+    const char *values[] = {country, exchange};
+    return _iter_open(client, _build_query(keys, values, 2), "stocks/tickers", NULL, NULL);
+}
+
+AxionIterator* axion_etfs_tickers_iter(AxionClient *client, const char *country, const char *exchange) {
+    const char *keys[] = {"country", "exchange"};
+    const char *values[] = {country, exchange};
+    return _iter_open(client, _build_query(keys, values, 2), "etfs/tickers", NULL, NULL);
+}
+
+AxionIterator* axion_crypto_tickers_iter(AxionClient *client, const char *type) {
+    const char *keys[] = {"type"};
+    const char *values[] = {type};
+    return _iter_open(client, _build_query(keys, values, 1), "crypto/tickers", NULL, NULL);
+}
+
+AxionIterator* axion_forex_tickers_iter(AxionClient *client, const char *country, const char *exchange) {
+    const char *keys[] = {"country", "exchange"};
+    const char *values[] = {country, exchange};
+    return _iter_open(client, _build_query(keys, values, 2), "forex/tickers", NULL, NULL);
+}
+
+AxionIterator* axion_futures_tickers_iter(AxionClient *client, const char *exchange) {
+    const char *keys[] = {"exchange"};
+    const char *values[] = {exchange};
+    return _iter_open(client, _build_query(keys, values, 1), "futures/tickers", NULL, NULL);
+}
+
+AxionIterator* axion_indices_tickers_iter(AxionClient *client, const char *exchange) {
+    const char *keys[] = {"exchange"};
+    const char *values[] = {exchange};
+    return _iter_open(client, _build_query(keys, values, 1), "indices/tickers", NULL, NULL);
+}
+
+AxionIterator* axion_filings_history_iter(AxionClient *client, const char *ticker, const char *form_type,
+                                          const char *start_date, const char *end_date) {
+    const char *keys[2];
+    const char *values[2];
+    int count = 0;
+    if (start_date) { keys[count] = "startDate"; values[count++] = start_date; }
+    if (end_date)   { keys[count] = "endDate";   values[count++] = end_date; }
+    char *query = (count > 0) ? _build_query(keys, values, count) : NULL;
+    return _iter_open(client, query, "filings/%s/%s", ticker, form_type);
+}
+
+AxionIterator* axion_news_general_iter(AxionClient *client) {
+    return _iter_open(client, NULL, "news", NULL, NULL);
+}
+
+AxionIterator* axion_news_company_iter(AxionClient *client, const char *ticker) {
+    return _iter_open(client, NULL, "news/%s", ticker, NULL);
+}
+
+AxionIterator* axion_news_country_iter(AxionClient *client, const char *country) {
+    return _iter_open(client, NULL, "news/country/%s", country, NULL);
+}
+
+AxionIterator* axion_news_category_iter(AxionClient *client, const char *category) {
+    return _iter_open(client, NULL, "news/category/%s", category, NULL);
+}
@@ -0,0 +1,116 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------
+// Rate limiting
+// ---------------------------------------------------------------------
+// Each bucket is a GCRA limiter, the token bucket expressed as a single
+// "theoretical arrival time" (TAT). A request reserves the slot T after
+// max(TAT, now) and must wait until TAT - now is within the burst
+// allowance (B - 1) * T. The reservation is one compare-and-swap, so any
+// number of threads can draw from a bucket without a lock.
+
+typedef struct {
+    int64_t interval_ns;    // T = 1 / rate; 0 means unlimited
+    int64_t tolerance_ns;   // (burst - 1) * T
+    int64_t tat_ns;
+} AxionBucket;
+
+struct AxionLimiter {
+    int refcount;
+    AxionBucket key;                            // Every request made with the API key
+    AxionBucket family[AXION_FAMILY_COUNT];
+};
+
+static int64_t _now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+AxionLimiter* _axion_limiter_new(void) {
+    AxionLimiter *limiter = calloc(1, sizeof(AxionLimiter));
+    if (!limiter) {
+        fprintf(stderr, "error: failed to allocate memory for rate limiter.\n");
+        return NULL;
+    }
+    limiter->refcount = 1;
+    return limiter;
+}
+
+AxionLimiter* _axion_limiter_retain(AxionLimiter *limiter) {
+    if (limiter) __atomic_add_fetch(&limiter->refcount, 1, __ATOMIC_RELAXED);
+    return limiter;
+}
+
+void _axion_limiter_release(AxionLimiter *limiter) {
+    if (!limiter) return;
+    if (__atomic_sub_fetch(&limiter->refcount, 1, __ATOMIC_ACQ_REL) != 0) return;
+    free(limiter);
+}
+
+// Reserves the next slot in the bucket; returns how long to wait for it
+static int64_t _bucket_reserve(AxionBucket *bucket, int64_t now) {
+    int64_t interval = __atomic_load_n(&bucket->interval_ns, __ATOMIC_RELAXED);
+    if (interval == 0) return 0;
+    int64_t tolerance = __atomic_load_n(&bucket->tolerance_ns, __ATOMIC_RELAXED);
+
+    int64_t tat = __atomic_load_n(&bucket->tat_ns, __ATOMIC_RELAXED);
+    int64_t next;
+    do {
+        next = (tat > now ? tat : now) + interval;
+    } while (!__atomic_compare_exchange_n(&bucket->tat_ns, &tat, next, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    int64_t wait = tat - now - tolerance;
+    return wait > 0 ? wait : 0;
+}
+
+// Takes one request from the key-wide bucket and the family's bucket and
+// returns the milliseconds the caller must wait before sending it
+long _axion_limiter_reserve(AxionLimiter *limiter, AxionEndpointFamily family) {
+    if (!limiter) return 0;
+    int64_t now = _now_ns();
+    int64_t wait = _bucket_reserve(&limiter->key, now);
+    int64_t family_wait = _bucket_reserve(&limiter->family[family], now);
+    if (family_wait > wait) wait = family_wait;
+    return (long)((wait + 999999) / 1000000);
+}
+
+static void _bucket_refund(AxionBucket *bucket) {
+    int64_t interval = __atomic_load_n(&bucket->interval_ns, __ATOMIC_RELAXED);
+    if (interval == 0) return;
+    // A TAT pushed into the past is harmless; reservations start from now
+    __atomic_sub_fetch(&bucket->tat_ns, interval, __ATOMIC_RELAXED);
+}
+
+// Gives back a reservation whose request was never sent, e.g. because the
+// deadline or cancel token ended the call while it waited for its turn
+void _axion_limiter_refund(AxionLimiter *limiter, AxionEndpointFamily family) {
+    if (!limiter) return;
+    _bucket_refund(&limiter->key);
+    _bucket_refund(&limiter->family[family]);
+}
+
+static void _bucket_configure(AxionBucket *bucket, double requests_per_second, int burst) {
+    int64_t interval = 0;
+    if (requests_per_second > 0) {
+        interval = (int64_t)(1e9 / requests_per_second);
+        if (interval < 1) interval = 1;
+    }
+    if (burst < 1) burst = 1;
+    __atomic_store_n(&bucket->tolerance_ns, interval * (burst - 1), __ATOMIC_RELAXED);
+    __atomic_store_n(&bucket->interval_ns, interval, __ATOMIC_RELAXED);
+}
+
+void axion_set_rate_limit(AxionClient *client, double requests_per_second, int burst) {
+    if (!client || !client->limiter) return;
+    _bucket_configure(&client->limiter->key, requests_per_second, burst);
+}
+
+void axion_set_family_rate_limit(AxionClient *client, AxionEndpointFamily family,
+                                 double requests_per_second, int burst) {
+    if (!client || !client->limiter || (int)family < 0 || family >= AXION_FAMILY_COUNT) return;
+    _bucket_configure(&client->limiter->family[family], requests_per_second, burst);
+}
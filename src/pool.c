@@ -0,0 +1,209 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// ---------------------------------------------------------------------
+// Shared connection state
+// ---------------------------------------------------------------------
+static void _share_lock(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr) {
+    (void)handle;
+    (void)access;
+    AxionShare *share = (AxionShare *)userptr;
+    pthread_mutex_lock(&share->locks[data]);
+}
+
+static void _share_unlock(CURL *handle, curl_lock_data data, void *userptr) {
+    (void)handle;
+    AxionShare *share = (AxionShare *)userptr;
+    pthread_mutex_unlock(&share->locks[data]);
+}
+
+AxionShare* _axion_share_new(void) {
+    AxionShare *share = malloc(sizeof(AxionShare));
+    if (!share) {
+        fprintf(stderr, "error: failed to allocate memory for share.\n");
+        return NULL;
+    }
+
+    share->handle = curl_share_init();
+    if (!share->handle) {
+        fprintf(stderr, "error: curl_share_init() failed.\n");
+        free(share);
+        return NULL;
+    }
+
+    int i;
+    for (i = 0; i < CURL_LOCK_DATA_LAST; i++) {
+        pthread_mutex_init(&share->locks[i], NULL);
+    }
+    share->refcount = 1;
+
+    curl_share_setopt(share->handle, CURLSHOPT_LOCKFUNC, _share_lock);
+    curl_share_setopt(share->handle, CURLSHOPT_UNLOCKFUNC, _share_unlock);
+    curl_share_setopt(share->handle, CURLSHOPT_USERDATA, (void *)share);
+    curl_share_setopt(share->handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share->handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    // Not CURL_LOCK_DATA_CONNECT: libcurl does not support one connection
+    // cache used by concurrently running threads, even with these locks.
+    // Connections stay with the pooled handle (or batch multi) that opened
+    // them instead, and those are only used by one thread at a time.
+    return share;
+}
+
+AxionShare* _axion_share_retain(AxionShare *share) {
+    if (share) __atomic_add_fetch(&share->refcount, 1, __ATOMIC_RELAXED);
+    return share;
+}
+
+void _axion_share_release(AxionShare *share) {
+    if (!share) return;
+    if (__atomic_sub_fetch(&share->refcount, 1, __ATOMIC_ACQ_REL) != 0) return;
+
+    // Every client has cleaned up its handles by now, so the share is free
+    curl_share_cleanup(share->handle);
+    int i;
+    for (i = 0; i < CURL_LOCK_DATA_LAST; i++) {
+        pthread_mutex_destroy(&share->locks[i]);
+    }
+    free(share);
+}
+
+void _axion_pool_init(AxionClient *client) {
+    pthread_mutex_init(&client->pool_lock, NULL);
+    client->idle_count = 0;
+    client->idle_multi = NULL;
+    client->spare_count = 0;
+    memset(client->size_hints, 0, sizeof(client->size_hints));
+}
+
+void _axion_pool_cleanup(AxionClient *client) {
+    int i;
+    for (i = 0; i < client->idle_count; i++) {
+        curl_easy_cleanup(client->idle_handles[i]);
+    }
+    client->idle_count = 0;
+    if (client->idle_multi) curl_multi_cleanup(client->idle_multi);
+    client->idle_multi = NULL;
+    for (i = 0; i < client->spare_count; i++) {
+        free(client->spare_buffers[i]);
+    }
+    client->spare_count = 0;
+    pthread_mutex_destroy(&client->pool_lock);
+}
+
+// ---------------------------------------------------------------------
+// Easy handle pool
+// ---------------------------------------------------------------------
+CURL* _axion_handle_acquire(AxionClient *client) {
+    CURL *curl = NULL;
+
+    pthread_mutex_lock(&client->pool_lock);
+    if (client->idle_count > 0) {
+        curl = client->idle_handles[--client->idle_count];
+    }
+    pthread_mutex_unlock(&client->pool_lock);
+
+    if (!curl) {
+        curl = curl_easy_init();
+        if (!curl) {
+            fprintf(stderr, "error: curl_easy_init() failed.\n");
+            return NULL;
+        }
+    }
+    curl_easy_setopt(curl, CURLOPT_SHARE, client->share->handle);
+    return curl;
+}
+
+void _axion_handle_release(AxionClient *client, CURL *curl) {
+    if (!curl) return;
+
+    // Drop any per-call options so the next borrower starts clean; the
+    // handle's live connections survive the reset
+    curl_easy_reset(curl);
+
+    pthread_mutex_lock(&client->pool_lock);
+    if (client->idle_count < AXION_MAX_IDLE_HANDLES) {
+        client->idle_handles[client->idle_count++] = curl;
+        curl = NULL;
+    }
+    pthread_mutex_unlock(&client->pool_lock);
+
+    if (curl) curl_easy_cleanup(curl);
+}
+
+// ---------------------------------------------------------------------
+// Multi handle cache for the batch engine
+// ---------------------------------------------------------------------
+CURLM* _axion_multi_acquire(AxionClient *client) {
+    CURLM *multi;
+
+    pthread_mutex_lock(&client->pool_lock);
+    multi = client->idle_multi;
+    client->idle_multi = NULL;
+    pthread_mutex_unlock(&client->pool_lock);
+
+    if (!multi) {
+        multi = curl_multi_init();
+        if (!multi) fprintf(stderr, "error: curl_multi_init() failed.\n");
+    }
+    return multi;
+}
+
+void _axion_multi_release(AxionClient *client, CURLM *multi) {
+    if (!multi) return;
+
+    pthread_mutex_lock(&client->pool_lock);
+    if (!client->idle_multi) {
+        client->idle_multi = multi;
+        multi = NULL;
+    }
+    pthread_mutex_unlock(&client->pool_lock);
+
+    if (multi) curl_multi_cleanup(multi);
+}
+
+// ---------------------------------------------------------------------
+// Body buffer reuse
+// ---------------------------------------------------------------------
+// Hands out a spare body buffer of at least *capacity bytes, growing one if
+// needed, and reports the buffer's real capacity back through *capacity
+char* _axion_buffer_acquire(AxionClient *client, size_t *capacity) {
+    char *buffer = NULL;
+    size_t have = 0;
+
+    pthread_mutex_lock(&client->pool_lock);
+    if (client->spare_count > 0) {
+        int i = --client->spare_count;
+        buffer = client->spare_buffers[i];
+        have = client->spare_capacity[i];
+    }
+    pthread_mutex_unlock(&client->pool_lock);
+
+    if (have >= *capacity) {
+        *capacity = have;
+        return buffer;
+    }
+    char *grown = realloc(buffer, *capacity);
+    if (!grown) free(buffer);
+    return grown;
+}
+
+// Keeps a buffer the caller never saw for the next transfer; very large
+// ones are freed so one huge response does not pin its memory for good
+void _axion_buffer_release(AxionClient *client, char *buffer, size_t capacity) {
+    if (!buffer) return;
+
+    if (capacity <= AXION_MAX_SPARE_BUFFER_SIZE) {
+        pthread_mutex_lock(&client->pool_lock);
+        if (client->spare_count < AXION_MAX_SPARE_BUFFERS) {
+            client->spare_buffers[client->spare_count] = buffer;
+            client->spare_capacity[client->spare_count] = capacity;
+            client->spare_count++;
+            buffer = NULL;
+        }
+        pthread_mutex_unlock(&client->pool_lock);
+    }
+
+    if (buffer) free(buffer);
+}
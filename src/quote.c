@@ -0,0 +1,192 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <math.h>
+
+// ---------------------------------------------------------------------
+// Quote decoding
+// ---------------------------------------------------------------------
+// Field names accepted for each AxionQuote member, matched case-insensitively
+typedef struct {
+    const char *names[4];
+    size_t offset;
+} QuoteField;
+
+static const QuoteField quote_fields[] = {
+    { { "price", "last", "regularMarketPrice", "c" }, offsetof(AxionQuote, price) },
+    { { "change", "regularMarketChange", "d", NULL }, offsetof(AxionQuote, change) },
+    { { "changePercent", "change_percent", "percentChange", "dp" }, offsetof(AxionQuote, change_percent) },
+    { { "open", "regularMarketOpen", "o", NULL }, offsetof(AxionQuote, open) },
+    { { "high", "dayHigh", "regularMarketDayHigh", "h" }, offsetof(AxionQuote, high) },
+    { { "low", "dayLow", "regularMarketDayLow", "l" }, offsetof(AxionQuote, low) },
+    { { "previousClose", "previous_close", "regularMarketPreviousClose", "pc" }, offsetof(AxionQuote, previous_close) },
+    { { "volume", "regularMarketVolume", "v", NULL }, offsetof(AxionQuote, volume) },
+};
+
+static const char *timestamp_names[] = { "timestamp", "time", "datetime", "date", "t" };
+
+static const cJSON* _quote_object(const cJSON *json) {
+    const cJSON *data = cJSON_GetObjectItemCaseSensitive(json, "data");
+    if (cJSON_IsObject(data)) return data;
+    if (cJSON_IsArray(data)) return cJSON_GetArrayItem(data, 0);
+    if (cJSON_IsArray(json)) return cJSON_GetArrayItem(json, 0);
+    return json;
+}
+
+static void _quote_decode(AxionQuote *quote, const cJSON *json) {
+    const cJSON *obj = _quote_object(json);
+    size_t f, n;
+    for (f = 0; f < sizeof(quote_fields) / sizeof(quote_fields[0]); f++) {
+        double *slot = (double *)((char *)quote + quote_fields[f].offset);
+        for (n = 0; n < 4 && quote_fields[f].names[n]; n++) {
+            const cJSON *item = cJSON_GetObjectItem(obj, quote_fields[f].names[n]);
+            if (item) {
+                *slot = _axion_json_number(item);
+                break;
+            }
+        }
+    }
+
+    for (n = 0; n < sizeof(timestamp_names) / sizeof(timestamp_names[0]); n++) {
+        const cJSON *item = cJSON_GetObjectItem(obj, timestamp_names[n]);
+        if (cJSON_IsNumber(item)) {
+            quote->timestamp = _axion_epoch_seconds(item->valuedouble);
+            break;
+        }
+        if (cJSON_IsString(item) && _axion_parse_timestamp(item->valuestring, &quote->timestamp) == 0) break;
+    }
+}
+
+// ---------------------------------------------------------------------
+// Fan-out over the batch engine
+// ---------------------------------------------------------------------
+typedef AxionResponse* (*QuoteCall)(AxionClient *client, const char *ticker);
+
+typedef struct {
+    AxionQuotes *quotes;
+    size_t *slots;      // Batch entry index -> quote index
+} QuoteBatch;
+
+static void _quote_store(AxionQuotes *quotes, size_t index, const AxionResponse *response) {
+    AxionQuote *quote = &quotes->quotes[index];
+    if (!response) {
+        quote->error = strdup("Failed to queue quote request.");
+        quotes->failed++;
+        return;
+    }
+    quote->http_status = response->http_status;
+    if (response->error) {
+        quote->error = strdup(response->error);
+        quotes->failed++;
+    } else if (!response->json) {
+        quote->error = strdup("Quote response has no JSON body.");
+        quotes->failed++;
+    } else {
+        _quote_decode(quote, response->json);
+    }
+}
+
+static void _quote_complete(AxionResponse *response, size_t index, void *userdata) {
+    QuoteBatch *ctx = (QuoteBatch *)userdata;
+    _quote_store(ctx->quotes, ctx->slots[index], response);
+}
+
+static AxionQuotes* _quotes(AxionClient *client, QuoteCall call, const char **tickers, size_t count) {
+    if (!client || (!tickers && count > 0)) return NULL;
+
+    AxionQuotes *quotes = calloc(1, sizeof(AxionQuotes));
+    if (!quotes || (count > 0 && !(quotes->quotes = calloc(count, sizeof(AxionQuote))))) {
+        fprintf(stderr, "error: failed to allocate memory for quotes.\n");
+        free(quotes);
+        return NULL;
+    }
+    quotes->count = count;
+
+    size_t i, f;
+    for (i = 0; i < count; i++) {
+        AxionQuote *quote = &quotes->quotes[i];
+        snprintf(quote->ticker, sizeof(quote->ticker), "%s", tickers[i] ? tickers[i] : "");
+        for (f = 0; f < sizeof(quote_fields) / sizeof(quote_fields[0]); f++) {
+            *(double *)((char *)quote + quote_fields[f].offset) = NAN;
+        }
+    }
+    if (count == 0) return quotes;
+
+    // The service has no multi-ticker quote endpoint, so the calls are
+    // queued into one batch and share its connections and streams
+    QuoteBatch ctx = { quotes, malloc(count * sizeof(size_t)) };
+    AxionResponse **responses = malloc(count * sizeof(AxionResponse *));
+    AxionBatch *batch = (ctx.slots && responses) ? axion_batch_begin(client) : NULL;
+    if (!batch) {
+        free(ctx.slots);
+        free(responses);
+        axion_quotes(quotes);
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++) {
+        size_t queued = axion_batch_size(batch);
+        // The request uses the caller's ticker; quote->ticker may be cut to fit
+        responses[i] = call(client, tickers[i] ? tickers[i] : "");
+        if (axion_batch_size(batch) > queued) {
+            ctx.slots[queued] = i;
+        } else {
+            // Not queued (e.g. out of memory); the call already ran on its own
+            _quote_store(quotes, i, responses[i]);
+        }
+    }
+    size_t queued = axion_batch_size(batch);
+    if (axion_batch_perform(batch, _quote_complete, &ctx) < 0) {
+        for (i = 0; i < queued; i++) {
+            AxionQuote *quote = &quotes->quotes[ctx.slots[i]];
+            if (quote->http_status == 0 && !quote->error) {
+                quote->error = strdup("Failed to perform quote batch.");
+                quotes->failed++;
+            }
+        }
+    }
+    axion_batch_free(batch);
+
+    for (i = 0; i < count; i++) {
+        axion_response(responses[i]);
+    }
+    free(responses);
+    free(ctx.slots);
+    return quotes;
+}
+
+AxionQuotes* axion_stocks_quotes(AxionClient *client, const char **tickers, size_t count) {
+    return _quotes(client, axion_stocks_quote, tickers, count);
+}
+
+AxionQuotes* axion_etfs_quotes(AxionClient *client, const char **tickers, size_t count) {
+    return _quotes(client, axion_etfs_quote, tickers, count);
+}
+
+AxionQuotes* axion_crypto_quotes(AxionClient *client, const char **tickers, size_t count) {
+    return _quotes(client, axion_crypto_quote, tickers, count);
+}
+
+AxionQuotes* axion_forex_quotes(AxionClient *client, const char **tickers, size_t count) {
+    return _quotes(client, axion_forex_quote, tickers, count);
+}
+
+AxionQuotes* axion_futures_quotes(AxionClient *client, const char **tickers, size_t count) {
+    return _quotes(client, axion_futures_quote, tickers, count);
+}
+
+AxionQuotes* axion_indices_quotes(AxionClient *client, const char **tickers, size_t count) {
+    return _quotes(client, axion_indices_quote, tickers, count);
+}
+
+void axion_quotes(AxionQuotes *quotes) {
+    if (!quotes) return;
+    size_t i;
+    for (i = 0; i < quotes->count; i++) {
+        if (quotes->quotes[i].error) free(quotes->quotes[i].error);
+    }
+    free(quotes->quotes);
+    free(quotes);
+}
@@ -0,0 +1,259 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------
+// Retry policy
+// ---------------------------------------------------------------------
+// Every endpoint is a GET, so any attempt can be repeated safely. Retries
+// back off exponentially with full jitter (a random delay up to the
+// current ceiling), which spreads out clients that failed together instead
+// of sending them back in lockstep.
+
+long _axion_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+void _axion_sleep_ms(long ms) {
+    if (ms <= 0) return;
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000 };
+    while (nanosleep(&ts, &ts) != 0) {}
+}
+
+// xorshift64*, seeded per thread so concurrent callers draw different delays
+static long _jitter(long ceiling) {
+    static _Thread_local uint64_t state = 0;
+    if (ceiling <= 0) return 0;
+    if (state == 0) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        state = ((uint64_t)ts.tv_nsec << 20) ^ (uint64_t)(uintptr_t)&state ^ (uint64_t)ts.tv_sec;
+        if (state == 0) state = 1;
+    }
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (long)((state * 2685821657736338717ull) >> 33) % (ceiling + 1);
+}
+
+static int _retryable_status(long http_code) {
+    return http_code == 408 || http_code == 429 || http_code == 500 ||
+           http_code == 502 || http_code == 503 || http_code == 504;
+}
+
+static int _retryable_error(CURLcode res) {
+    switch (res) {
+    case CURLE_COULDNT_RESOLVE_HOST:
+    case CURLE_COULDNT_CONNECT:
+    case CURLE_OPERATION_TIMEDOUT:
+    case CURLE_SSL_CONNECT_ERROR:
+    case CURLE_SEND_ERROR:
+    case CURLE_RECV_ERROR:
+    case CURLE_GOT_NOTHING:
+    case CURLE_PARTIAL_FILE:
+    case CURLE_HTTP2:
+    case CURLE_HTTP2_STREAM:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// Returns how long to wait before repeating a finished attempt (attempt
+// counts from 1), or -1 if its outcome should be returned as it is
+long _axion_retry_delay(AxionClient *client, CURL *curl, const AxionTransfer *transfer, CURLcode res, int attempt) {
+    if (attempt >= client->max_attempts) return -1;
+
+    long http_code = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    // Part of a successful body may already have reached a streaming consumer
+    if (transfer->sink && http_code > 0 && http_code < 400 && transfer->decoded_bytes > 0) return -1;
+
+    if (res == CURLE_OK) {
+        if (!_retryable_status(http_code)) return -1;
+    } else if (!_retryable_error(res)) {
+        return -1;
+    }
+
+    long ceiling = client->retry_base_ms;
+    int i;
+    for (i = 1; i < attempt && ceiling < client->retry_max_ms; i++) ceiling *= 2;
+    if (ceiling > client->retry_max_ms) ceiling = client->retry_max_ms;
+    long delay = _jitter(ceiling);
+
+    // A server asking for more patience than the policy allows gets its
+    // answer handed back rather than a caller blocked for minutes
+    curl_off_t retry_after = 0;
+    if (res == CURLE_OK && curl_easy_getinfo(curl, CURLINFO_RETRY_AFTER, &retry_after) == CURLE_OK &&
+        retry_after > 0) {
+        if (retry_after * 1000 > client->retry_max_ms) return -1;
+        if (retry_after * 1000 > delay) delay = (long)retry_after * 1000;
+    }
+    return delay;
+}
+
+// Empties a finished attempt's body so the same handle and buffer can go again
+void _axion_retry_reset(AxionTransfer *transfer) {
+    transfer->chunk.size = 0;
+    if (transfer->chunk.memory) transfer->chunk.memory[0] = 0;
+    transfer->decoded_bytes = 0;
+    transfer->sink_status = 0;
+}
+
+// Releases a transfer that lost a hedge without touching its response
+static void _transfer_discard(AxionClient *client, AxionTransfer *transfer) {
+    if (transfer->headers) curl_slist_free_all(transfer->headers);
+    transfer->headers = NULL;
+    if (transfer->chunk.arena) {
+        _axion_body_free(&transfer->chunk);
+    } else if (transfer->chunk.memory) {
+        _axion_buffer_release(client, transfer->chunk.memory, transfer->chunk.capacity);
+    }
+    transfer->chunk.memory = NULL;
+}
+
+// ---------------------------------------------------------------------
+// Hedged requests
+// ---------------------------------------------------------------------
+// If the first attempt has not finished after hedge_ms, an identical second
+// one is started and whichever succeeds first is kept. The duplicate costs
+// one extra request in the slow tail only, and trims that tail sharply.
+
+// A finished attempt that a retry would repeat did not answer the call
+static int _attempt_failed(CURL *curl, CURLcode res) {
+    long http_code = 0;
+    if (res != CURLE_OK) return 1;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    return _retryable_status(http_code);
+}
+static CURLcode _hedged_perform(AxionClient *client, CURL **curl, AxionTransfer *transfer, const char *url) {
+    CURLM *multi = _axion_multi_acquire(client);
+    if (!multi) return curl_easy_perform(*curl);
+    if (curl_multi_add_handle(multi, *curl) != CURLM_OK) {
+        _axion_multi_release(client, multi);
+        return curl_easy_perform(*curl);
+    }
+
+    AxionTransfer hedge;
+    memset(&hedge, 0, sizeof(hedge));
+    CURL *second = NULL;
+    int hedged = 0;
+    long start = _axion_now_ms();
+    int active = 1;
+    CURL *winner = NULL;
+    CURLcode res = CURLE_OK;
+    CURL *failed = NULL;
+    CURLcode failed_res = CURLE_OK;
+
+    while (!winner) {
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        CURLMsg *msg;
+        int queued;
+        while (!winner && (msg = curl_multi_info_read(multi, &queued))) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            active--;
+            if (!_attempt_failed(msg->easy_handle, msg->data.result)) {
+                winner = msg->easy_handle;
+                res = msg->data.result;
+            } else if (!failed) {
+                failed = msg->easy_handle;
+                failed_res = msg->data.result;
+            }
+        }
+        // A failure only stands once nothing else is left to answer; the
+        // deadline and timeouts end both attempts, so this cannot hang
+        if (!winner && active == 0) {
+            winner = failed;
+            res = failed_res;
+        }
+        if (winner) break;
+
+        long waited = _axion_now_ms() - start;
+        if (!hedged && waited >= client->hedge_ms) {
+            hedged = 1;
+            second = _axion_handle_acquire(client);
+            if (second) {
+                // The duplicate shares the original's validators, but not their ownership
+                hedge.response = transfer->response;
+                hedge.endpoint = transfer->endpoint;
+                hedge.name = transfer->name;
+                hedge.family = transfer->family;
+                hedge.started_us = transfer->started_us;
+                hedge.revalidate = transfer->revalidate;
+                if (_axion_transfer_setup(client, second, &hedge, url) != 0 ||
+                    curl_multi_add_handle(multi, second) != CURLM_OK) {
+                    _transfer_discard(client, &hedge);
+                    _axion_handle_release(client, second);
+                    second = NULL;
+                } else {
+                    active++;
+                }
+            }
+        }
+        int timeout = hedged ? 1000 : (int)(client->hedge_ms - waited);
+        curl_multi_poll(multi, NULL, 0, timeout > 0 ? timeout : 1, NULL);
+    }
+
+    curl_multi_remove_handle(multi, *curl);
+    if (second) curl_multi_remove_handle(multi, second);
+    _axion_multi_release(client, multi);
+
+    if (second && winner == second) {
+        // Keep the duplicate's body and handle; the original is abandoned
+        AxionValidators revalidate = transfer->revalidate;
+        _transfer_discard(client, transfer);
+        *transfer = hedge;
+        transfer->revalidate = revalidate;
+        _axion_handle_release(client, *curl);
+        *curl = second;
+        curl_easy_setopt(second, CURLOPT_WRITEDATA, (void *)transfer);
+        curl_easy_setopt(second, CURLOPT_XFERINFODATA, (void *)transfer);
+    } else if (second) {
+        _transfer_discard(client, &hedge);
+        _axion_handle_release(client, second);
+    }
+    return res;
+}
+
+// Performs a prepared transfer, pacing, hedging and retrying it as the
+// client's policy allows. *curl may be swapped for the handle that won a hedge.
+CURLcode _axion_perform(AxionClient *client, CURL **curl, AxionTransfer *transfer, const char *url,
+                        AxionEndpointFamily family) {
+    int hedge = client->hedge_ms > 0 && family == AXION_FAMILY_QUOTES && !transfer->sink;
+    int attempt = 0;
+    for (;;) {
+        const char *reason = _axion_call_pause(&transfer->limits, _axion_limiter_reserve(client->limiter, family));
+        if (reason) {
+            // The request is never sent, so its slot goes back to the budget
+            _axion_limiter_refund(client->limiter, family);
+            transfer->abort_reason = reason;
+            return CURLE_ABORTED_BY_CALLBACK;
+        }
+        curl_easy_setopt(*curl, CURLOPT_TIMEOUT_MS, _axion_call_timeout(client, transfer));
+
+        CURLcode res = hedge ? _hedged_perform(client, curl, transfer, url) : curl_easy_perform(*curl);
+        long delay = _axion_retry_delay(client, *curl, transfer, res, ++attempt);
+        // A retry that cannot finish before the deadline is not attempted
+        if (delay < 0 || _axion_call_pause(&transfer->limits, delay)) return res;
+        _axion_retry_reset(transfer);
+    }
+}
+
+void axion_set_retry(AxionClient *client, int max_attempts, int base_delay_ms, int max_delay_ms) {
+    if (!client) return;
+    client->max_attempts = max_attempts > 0 ? max_attempts : AXION_DEFAULT_MAX_ATTEMPTS;
+    client->retry_base_ms = base_delay_ms > 0 ? base_delay_ms : AXION_DEFAULT_RETRY_BASE_MS;
+    client->retry_max_ms = max_delay_ms > 0 ? max_delay_ms : AXION_DEFAULT_RETRY_MAX_MS;
+    if (client->retry_max_ms < client->retry_base_ms) client->retry_max_ms = client->retry_base_ms;
+}
+
+void axion_set_hedging(AxionClient *client, int delay_ms) {
+    if (!client) return;
+    client->hedge_ms = delay_ms > 0 ? delay_ms : 0;
+}
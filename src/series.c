@@ -0,0 +1,139 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define SERIES_ALIGNMENT 64
+#define SERIES_INITIAL_CAPACITY 256
+
+// Columns are grown together, so one capacity covers all six
+typedef struct {
+    AxionPriceSeries *series;
+    size_t capacity;
+    int failed;
+} SeriesBuilder;
+
+static void* _aligned_column(size_t capacity) {
+    size_t bytes = capacity * sizeof(double);
+    bytes = (bytes + SERIES_ALIGNMENT - 1) & ~(size_t)(SERIES_ALIGNMENT - 1);
+    return aligned_alloc(SERIES_ALIGNMENT, bytes);
+}
+
+// Moves a column into a larger aligned allocation (there is no aligned realloc)
+static int _grow_column(void **column, size_t count, size_t capacity) {
+    void *grown = _aligned_column(capacity);
+    if (!grown) return -1;
+    if (*column) {
+        memcpy(grown, *column, count * sizeof(double));
+        free(*column);
+    }
+    *column = grown;
+    return 0;
+}
+
+static int _series_reserve(SeriesBuilder *builder, size_t capacity) {
+    AxionPriceSeries *s = builder->series;
+    if (capacity <= builder->capacity) return 0;
+
+    if (_grow_column((void **)&s->timestamp, s->count, capacity) != 0 ||
+        _grow_column((void **)&s->open, s->count, capacity) != 0 ||
+        _grow_column((void **)&s->high, s->count, capacity) != 0 ||
+        _grow_column((void **)&s->low, s->count, capacity) != 0 ||
+        _grow_column((void **)&s->close, s->count, capacity) != 0 ||
+        _grow_column((void **)&s->volume, s->count, capacity) != 0) {
+        return -1;
+    }
+    builder->capacity = capacity;
+    return 0;
+}
+
+static int _series_append(const AxionBar *bar, void *userdata) {
+    SeriesBuilder *builder = (SeriesBuilder *)userdata;
+    AxionPriceSeries *s = builder->series;
+
+    if (s->count == builder->capacity) {
+        size_t capacity = builder->capacity ? builder->capacity * 2 : SERIES_INITIAL_CAPACITY;
+        if (_series_reserve(builder, capacity) != 0) {
+            builder->failed = 1;
+            return 1;
+        }
+    }
+
+    size_t i = s->count++;
+    s->timestamp[i] = bar->timestamp;
+    s->open[i] = bar->open;
+    s->high[i] = bar->high;
+    s->low[i] = bar->low;
+    s->close[i] = bar->close;
+    s->volume[i] = bar->volume;
+    return 0;
+}
+
+static AxionPriceSeries* _prices_series(AxionClient *client, const char *market, const char *ticker,
+                                        const char *from_date, const char *to_date, const char *frame) {
+    AxionPriceSeries *series = calloc(1, sizeof(AxionPriceSeries));
+    AxionBarStream *stream = malloc(sizeof(AxionBarStream));
+    if (!series || !stream) {
+        fprintf(stderr, "error: failed to allocate memory for price series.\n");
+        free(series);
+        free(stream);
+        return NULL;
+    }
+
+    SeriesBuilder builder = { series, 0, 0 };
+    _axion_bar_stream_init(stream, _series_append, &builder);
+    AxionSink sink = { _axion_bar_stream_write, _axion_bar_stream_finish, stream, NULL, 0 };
+
+    AxionResponse *resp = _axion_prices_sink(client, market, ticker, from_date, to_date, frame, &sink);
+    free(stream);
+    if (!resp) {
+        axion_price_series(series);
+        return NULL;
+    }
+
+    series->http_status = resp->http_status;
+    if (builder.failed) {
+        series->error = strdup("Failed to allocate memory for price series.");
+    } else if (resp->error) {
+        series->error = resp->error;
+        resp->error = NULL;
+    }
+    axion_response(resp);
+    return series;
+}
+
+AxionPriceSeries* axion_stocks_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
+    return _prices_series(client, "stocks", ticker, from_date, to_date, frame);
+}
+
+AxionPriceSeries* axion_etfs_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
+    return _prices_series(client, "etfs", ticker, from_date, to_date, frame);
+}
+
+AxionPriceSeries* axion_crypto_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
+    return _prices_series(client, "crypto", ticker, from_date, to_date, frame);
+}
+
+AxionPriceSeries* axion_forex_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
+    return _prices_series(client, "forex", ticker, from_date, to_date, frame);
+}
+
+AxionPriceSeries* axion_futures_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
+    return _prices_series(client, "futures", ticker, from_date, to_date, frame);
+}
+
+AxionPriceSeries* axion_indices_prices_series(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame) {
+    return _prices_series(client, "indices", ticker, from_date, to_date, frame);
+}
+
+void axion_price_series(AxionPriceSeries *series) {
+    if (!series) return;
+    free(series->timestamp);
+    free(series->open);
+    free(series->high);
+    free(series->low);
+    free(series->close);
+    free(series->volume);
+    if (series->error) free(series->error);
+    free(series);
+}
@@ -0,0 +1,238 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------
+// Per-endpoint statistics
+// ---------------------------------------------------------------------
+// Each endpoint template gets a record of counters and one log-linear
+// histogram per phase, in the style of HdrHistogram: every power of two is
+// split into 2^STATS_SUB_BITS equal buckets, so any recorded value is known
+// to within 12.5% from 1 us to hours. Recording is a handful of relaxed
+// atomic adds and never takes a lock.
+
+#define STATS_SUB_BITS 3
+#define STATS_SLOTS 128     // Endpoint records per client; a power of two
+
+struct AxionStats {
+    int refcount;
+    AxionEndpointStats *slots[STATS_SLOTS];   // Open addressing on the endpoint key
+};
+
+int64_t _axion_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int _bucket_index(uint64_t us) {
+    const uint64_t sub = 1u << STATS_SUB_BITS;
+    if (us < sub) return (int)us;
+    int exponent = 63 - __builtin_clzll(us);
+    int index = (exponent - STATS_SUB_BITS + 1) * (int)sub + (int)((us >> (exponent - STATS_SUB_BITS)) & (sub - 1));
+    return index < AXION_STATS_BUCKETS ? index : AXION_STATS_BUCKETS - 1;
+}
+
+// Midpoint of a bucket's range, in microseconds
+static double _bucket_value(int index) {
+    const int sub = 1 << STATS_SUB_BITS;
+    if (index < sub) return index;
+    int shift = index / sub - 1;
+    double low = (double)((uint64_t)(sub + index % sub) << shift);
+    return low + (double)((uint64_t)1 << shift) / 2;
+}
+
+AxionStats* _axion_stats_new(void) {
+    AxionStats *stats = calloc(1, sizeof(AxionStats));
+    if (!stats) {
+        fprintf(stderr, "error: failed to allocate memory for stats.\n");
+        return NULL;
+    }
+    stats->refcount = 1;
+    return stats;
+}
+
+AxionStats* _axion_stats_retain(AxionStats *stats) {
+    if (stats) __atomic_add_fetch(&stats->refcount, 1, __ATOMIC_RELAXED);
+    return stats;
+}
+
+void _axion_stats_release(AxionStats *stats) {
+    if (!stats) return;
+    if (__atomic_sub_fetch(&stats->refcount, 1, __ATOMIC_ACQ_REL) != 0) return;
+    int i;
+    for (i = 0; i < STATS_SLOTS; i++) free(stats->slots[i]);
+    free(stats);
+}
+
+// Finds the endpoint's record, claiming a free slot for it the first time.
+// Records are never moved or freed before the client, so once a slot is
+// filled it can be read without a lock.
+static AxionEndpointStats* _record_for(AxionStats *stats, const AxionTransfer *transfer) {
+    const char *name = transfer->name ? transfer->name : "";
+    unsigned probe;
+    for (probe = 0; probe < STATS_SLOTS; probe++) {
+        AxionEndpointStats **slot = &stats->slots[(transfer->endpoint + probe) & (STATS_SLOTS - 1)];
+        AxionEndpointStats *record = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+        if (!record) {
+            AxionEndpointStats *fresh = calloc(1, sizeof(AxionEndpointStats));
+            if (!fresh) return NULL;
+            snprintf(fresh->endpoint, sizeof(fresh->endpoint), "%s", name);
+            fresh->family = transfer->family;
+            if (__atomic_compare_exchange_n(slot, &record, fresh, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                return fresh;
+            }
+            // Another thread filled the slot first, maybe for this endpoint
+            free(fresh);
+        }
+        if (strncmp(record->endpoint, name, sizeof(record->endpoint) - 1) == 0) return record;
+    }
+    return NULL;    // Table full; further endpoints go unrecorded
+}
+
+static void _add(uint64_t *counter, uint64_t value) {
+    __atomic_add_fetch(counter, value, __ATOMIC_RELAXED);
+}
+
+// Folds a finished transfer's response stats into its endpoint's record
+void _axion_stats_record(AxionClient *client, const AxionTransfer *transfer) {
+    if (!client->stats) return;
+    AxionEndpointStats *record = _record_for(client->stats, transfer);
+    if (!record) return;
+
+    const AxionResponseStats *rs = &AXION_IMPL(transfer->response)->stats;
+    _add(&record->calls, 1);
+    if (transfer->response->error) _add(&record->errors, 1);
+    _add(&record->bytes_in, rs->header_bytes + rs->wire_bytes);
+    _add(&record->bytes_out, rs->request_bytes);
+
+    int phase;
+    for (phase = 0; phase < AXION_PHASE_COUNT; phase++) {
+        // Streamed, raw-only and 304 calls build no tree; a 0 us sample
+        // would only drag the parse percentiles down
+        if (phase == AXION_PHASE_PARSE && !transfer->response->json) continue;
+        uint64_t us = rs->phase_us[phase];
+        _add(&record->sum_us[phase], us);
+        __atomic_add_fetch(&record->histogram[phase][_bucket_index(us)], 1, __ATOMIC_RELAXED);
+        uint64_t max = __atomic_load_n(&record->max_us[phase], __ATOMIC_RELAXED);
+        while (us > max && !__atomic_compare_exchange_n(&record->max_us[phase], &max, us, 1,
+                                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+    }
+}
+
+// ---------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------
+static void _snapshot(AxionEndpointStats *out, const AxionEndpointStats *record) {
+    memcpy(out->endpoint, record->endpoint, sizeof(out->endpoint));
+    out->family = record->family;
+    out->calls = __atomic_load_n(&record->calls, __ATOMIC_RELAXED);
+    out->errors = __atomic_load_n(&record->errors, __ATOMIC_RELAXED);
+    out->bytes_in = __atomic_load_n(&record->bytes_in, __ATOMIC_RELAXED);
+    out->bytes_out = __atomic_load_n(&record->bytes_out, __ATOMIC_RELAXED);
+    int phase, b;
+    for (phase = 0; phase < AXION_PHASE_COUNT; phase++) {
+        out->sum_us[phase] = __atomic_load_n(&record->sum_us[phase], __ATOMIC_RELAXED);
+        out->max_us[phase] = __atomic_load_n(&record->max_us[phase], __ATOMIC_RELAXED);
+        for (b = 0; b < AXION_STATS_BUCKETS; b++) {
+            out->histogram[phase][b] = __atomic_load_n(&record->histogram[phase][b], __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void _merge(AxionEndpointStats *into, const AxionEndpointStats *from) {
+    into->calls += from->calls;
+    into->errors += from->errors;
+    into->bytes_in += from->bytes_in;
+    into->bytes_out += from->bytes_out;
+    int phase, b;
+    for (phase = 0; phase < AXION_PHASE_COUNT; phase++) {
+        into->sum_us[phase] += from->sum_us[phase];
+        if (from->max_us[phase] > into->max_us[phase]) into->max_us[phase] = from->max_us[phase];
+        for (b = 0; b < AXION_STATS_BUCKETS; b++) into->histogram[phase][b] += from->histogram[phase][b];
+    }
+}
+
+size_t axion_stats(AxionClient *client, AxionEndpointStats *out, size_t max) {
+    if (!client || !client->stats) return 0;
+    size_t count = 0;
+    int i;
+    for (i = 0; i < STATS_SLOTS; i++) {
+        const AxionEndpointStats *record = __atomic_load_n(&client->stats->slots[i], __ATOMIC_ACQUIRE);
+        if (!record) continue;
+        if (out && count < max) _snapshot(&out[count], record);
+        count++;
+    }
+    return count;
+}
+
+int axion_stats_family(AxionClient *client, AxionEndpointFamily family, AxionEndpointStats *out) {
+    if (!client || !client->stats || !out || (int)family < 0 || family >= AXION_FAMILY_COUNT) return -1;
+    memset(out, 0, sizeof(*out));
+    out->family = family;
+
+    AxionEndpointStats *scratch = malloc(sizeof(AxionEndpointStats));
+    if (!scratch) return -1;
+    int i;
+    for (i = 0; i < STATS_SLOTS; i++) {
+        const AxionEndpointStats *record = __atomic_load_n(&client->stats->slots[i], __ATOMIC_ACQUIRE);
+        if (!record || record->family != family) continue;
+        _snapshot(scratch, record);
+        _merge(out, scratch);
+    }
+    free(scratch);
+    return 0;
+}
+
+double axion_stats_percentile(const AxionEndpointStats *stats, AxionPhase phase, double percentile) {
+    if (!stats || (int)phase < 0 || phase >= AXION_PHASE_COUNT) return 0;
+    uint64_t total = 0;
+    int b;
+    for (b = 0; b < AXION_STATS_BUCKETS; b++) total += stats->histogram[phase][b];
+    if (total == 0) return 0;
+    if (percentile < 0) percentile = 0;
+    if (percentile > 100) percentile = 100;
+
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)total + 0.5);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (b = 0; b < AXION_STATS_BUCKETS; b++) {
+        seen += stats->histogram[phase][b];
+        if (seen >= rank) break;
+    }
+    double value = _bucket_value(b);
+    if (value > (double)stats->max_us[phase]) value = (double)stats->max_us[phase];
+    return value / 1000.0;
+}
+
+double axion_stats_mean(const AxionEndpointStats *stats, AxionPhase phase) {
+    if (!stats || (int)phase < 0 || phase >= AXION_PHASE_COUNT) return 0;
+    // Not every call has every phase, so the histogram holds the sample count
+    uint64_t samples = 0;
+    int b;
+    for (b = 0; b < AXION_STATS_BUCKETS; b++) samples += stats->histogram[phase][b];
+    if (samples == 0) return 0;
+    return (double)stats->sum_us[phase] / (double)samples / 1000.0;
+}
+
+void axion_stats_reset(AxionClient *client) {
+    if (!client || !client->stats) return;
+    int i, phase, b;
+    for (i = 0; i < STATS_SLOTS; i++) {
+        AxionEndpointStats *record = __atomic_load_n(&client->stats->slots[i], __ATOMIC_ACQUIRE);
+        if (!record) continue;
+        __atomic_store_n(&record->calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&record->errors, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&record->bytes_in, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&record->bytes_out, 0, __ATOMIC_RELAXED);
+        for (phase = 0; phase < AXION_PHASE_COUNT; phase++) {
+            __atomic_store_n(&record->sum_us[phase], 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&record->max_us[phase], 0, __ATOMIC_RELAXED);
+            for (b = 0; b < AXION_STATS_BUCKETS; b++) {
+                __atomic_store_n(&record->histogram[phase][b], 0, __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
@@ -0,0 +1,409 @@
+#include "axion_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include <math.h>
+
+// ---------------------------------------------------------------------
+// Field and timestamp helpers
+// ---------------------------------------------------------------------
+enum {
+    BAR_FIELD_DATE = 0,
+    BAR_FIELD_OPEN,
+    BAR_FIELD_HIGH,
+    BAR_FIELD_LOW,
+    BAR_FIELD_CLOSE,
+    BAR_FIELD_VOLUME
+};
+
+#define BAR_HAS_PRICE ((1u << BAR_FIELD_OPEN) | (1u << BAR_FIELD_HIGH) | \
+                       (1u << BAR_FIELD_LOW) | (1u << BAR_FIELD_CLOSE))
+
+// Maps a JSON key to the bar field it carries, or -1 if it is not one
+static int _bar_field(const char *key) {
+    static const struct { const char *name; int field; } names[] = {
+        {"date", BAR_FIELD_DATE}, {"time", BAR_FIELD_DATE}, {"datetime", BAR_FIELD_DATE},
+        {"timestamp", BAR_FIELD_DATE}, {"t", BAR_FIELD_DATE},
+        {"open", BAR_FIELD_OPEN}, {"o", BAR_FIELD_OPEN},
+        {"high", BAR_FIELD_HIGH}, {"h", BAR_FIELD_HIGH},
+        {"low", BAR_FIELD_LOW}, {"l", BAR_FIELD_LOW},
+        {"close", BAR_FIELD_CLOSE}, {"c", BAR_FIELD_CLOSE},
+        {"volume", BAR_FIELD_VOLUME}, {"v", BAR_FIELD_VOLUME},
+    };
+    size_t i;
+    for (i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcasecmp(key, names[i].name) == 0) return names[i].field;
+    }
+    return -1;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date
+static int64_t _days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+static int _read_digits(const char **p, int n) {
+    int v = 0;
+    while (n-- > 0) {
+        if (**p < '0' || **p > '9') return -1;
+        v = v * 10 + (*(*p)++ - '0');
+    }
+    return v;
+}
+
+// Parses "YYYY-MM-DD[ T]HH:MM[:SS[.fff]][Z|+hh:mm]" into seconds since the epoch (UTC)
+int _axion_parse_timestamp(const char *s, int64_t *out) {
+    const char *p = s;
+    int year = _read_digits(&p, 4);
+    if (year < 0 || *p++ != '-') return -1;
+    int month = _read_digits(&p, 2);
+    if (month < 1 || month > 12 || *p++ != '-') return -1;
+    int day = _read_digits(&p, 2);
+    if (day < 1 || day > 31) return -1;
+
+    int64_t secs = _days_from_civil(year, (unsigned)month, (unsigned)day) * 86400;
+    if (*p == 'T' || *p == ' ') {
+        p++;
+        int hh = _read_digits(&p, 2);
+        if (hh < 0 || *p++ != ':') return -1;
+        int mm = _read_digits(&p, 2);
+        if (mm < 0) return -1;
+        int ss = 0;
+        if (*p == ':') {
+            p++;
+            ss = _read_digits(&p, 2);
+            if (ss < 0) return -1;
+        }
+        if (*p == '.') {
+            p++;
+            while (*p >= '0' && *p <= '9') p++;
+        }
+        secs += hh * 3600 + mm * 60 + ss;
+        if (*p == '+' || *p == '-') {
+            int sign = (*p++ == '-') ? -1 : 1;
+            int oh = _read_digits(&p, 2);
+            if (oh < 0) return -1;
+            if (*p == ':') p++;
+            int om = _read_digits(&p, 2);
+            if (om < 0) return -1;
+            secs -= sign * (oh * 3600 + om * 60);
+        }
+    }
+    *out = secs;
+    return 0;
+}
+
+// Correctly rounded, locale-independent conversion of a NUL-terminated JSON number token
+double _axion_parse_double(const char *token) {
+    double value = 0;
+    cJSON_ParseDouble(token, strlen(token), &value);
+    return value;
+}
+
+// Numbers may arrive as JSON numbers or as numeric strings; anything else is NAN
+double _axion_json_number(const cJSON *item) {
+    if (cJSON_IsNumber(item)) return item->valuedouble;
+    if (cJSON_IsString(item) && item->valuestring) {
+        double value;
+        if (cJSON_ParseDouble(item->valuestring, strlen(item->valuestring), &value) != 0) return value;
+    }
+    return NAN;
+}
+
+// Numeric timestamps may be in seconds or milliseconds since the epoch.
+// Millisecond epochs are common; anything past year 5138 in seconds is one.
+int64_t _axion_epoch_seconds(double t) {
+    return (int64_t)(fabs(t) >= 1e11 ? t / 1000.0 : t);
+}
+
+// ---------------------------------------------------------------------
+// Incremental tokenizer
+// ---------------------------------------------------------------------
+void _axion_bar_stream_init(AxionBarStream *stream, AxionBarCallback on_bar, void *userdata) {
+    memset(stream, 0, sizeof(*stream));
+    stream->on_bar = on_bar;
+    stream->userdata = userdata;
+    stream->key_field = -1;
+}
+
+static void _token_push(AxionBarStream *stream, char c) {
+    if (stream->token_len + 1 < sizeof(stream->token)) {
+        stream->token[stream->token_len++] = c;
+    } else {
+        stream->token_overflow = 1;
+    }
+}
+
+static void _token_push_utf8(AxionBarStream *stream, unsigned cp) {
+    if (cp < 0x80) {
+        _token_push(stream, (char)cp);
+    } else if (cp < 0x800) {
+        _token_push(stream, (char)(0xC0 | (cp >> 6)));
+        _token_push(stream, (char)(0x80 | (cp & 0x3F)));
+    } else {
+        _token_push(stream, (char)(0xE0 | (cp >> 12)));
+        _token_push(stream, (char)(0x80 | ((cp >> 6) & 0x3F)));
+        _token_push(stream, (char)(0x80 | (cp & 0x3F)));
+    }
+}
+
+// Assigns a completed scalar to the innermost object's bar, if its key is a bar field
+static void _on_scalar(AxionBarStream *stream, int is_string) {
+    if (stream->depth == 0 || stream->stack[stream->depth - 1] != '{') return;
+    int field = stream->key_field;
+    stream->key_field = -1;
+    if (field < 0 || stream->token_overflow) return;
+
+    AxionBarAccum *acc = &stream->acc[stream->depth - 1];
+    stream->token[stream->token_len] = '\0';
+
+    if (field == BAR_FIELD_DATE) {
+        if (is_string) {
+            if (_axion_parse_timestamp(stream->token, &acc->timestamp) != 0) return;
+            memcpy(acc->date, stream->token, stream->token_len + 1);
+        } else {
+            acc->timestamp = _axion_epoch_seconds(_axion_parse_double(stream->token));
+            acc->date[0] = '\0';
+        }
+    } else if (!is_string) {
+        acc->values[field - BAR_FIELD_OPEN] = _axion_parse_double(stream->token);
+    } else {
+        return;
+    }
+    acc->fields |= 1u << field;
+}
+
+// Emits the bar held by an object that just closed; returns non-zero to stop
+static int _on_object_end(AxionBarStream *stream, AxionBarAccum *acc) {
+    if (!(acc->fields & (1u << BAR_FIELD_DATE)) || !(acc->fields & BAR_HAS_PRICE)) return 0;
+
+    AxionBar bar;
+    bar.date = acc->date[0] ? acc->date : NULL;
+    bar.timestamp = acc->timestamp;
+    bar.open = (acc->fields & (1u << BAR_FIELD_OPEN)) ? acc->values[0] : NAN;
+    bar.high = (acc->fields & (1u << BAR_FIELD_HIGH)) ? acc->values[1] : NAN;
+    bar.low = (acc->fields & (1u << BAR_FIELD_LOW)) ? acc->values[2] : NAN;
+    bar.close = (acc->fields & (1u << BAR_FIELD_CLOSE)) ? acc->values[3] : NAN;
+    bar.volume = (acc->fields & (1u << BAR_FIELD_VOLUME)) ? acc->values[4] : NAN;
+    stream->bars++;
+    return stream->on_bar(&bar, stream->userdata) != 0;
+}
+
+static int _fail(AxionBarStream *stream, const char *message) {
+    stream->error = message;
+    return -1;
+}
+
+int _axion_bar_stream_write(void *ctx, const char *data, size_t len) {
+    AxionBarStream *stream = (AxionBarStream *)ctx;
+    size_t i = 0;
+
+    while (i < len) {
+        char c = data[i];
+
+        switch (stream->lex) {
+        case AXION_LEX_STRING:
+            i++;
+            if (c == '"') {
+                stream->lex = AXION_LEX_NONE;
+                if (stream->depth > 0 && stream->stack[stream->depth - 1] == '{' && stream->expect_key) {
+                    stream->token[stream->token_len] = '\0';
+                    stream->key_field = stream->token_overflow ? -1 : _bar_field(stream->token);
+                    stream->expect_key = 0;
+                } else {
+                    _on_scalar(stream, 1);
+                }
+            } else if (c == '\\') {
+                stream->lex = AXION_LEX_STRING_ESCAPE;
+            } else {
+                _token_push(stream, c);
+            }
+            continue;
+
+        case AXION_LEX_STRING_ESCAPE:
+            i++;
+            stream->lex = AXION_LEX_STRING;
+            switch (c) {
+            case 'b': _token_push(stream, '\b'); break;
+            case 'f': _token_push(stream, '\f'); break;
+            case 'n': _token_push(stream, '\n'); break;
+            case 'r': _token_push(stream, '\r'); break;
+            case 't': _token_push(stream, '\t'); break;
+            case 'u':
+                stream->lex = AXION_LEX_STRING_UNICODE;
+                stream->ucode = 0;
+                stream->uhex = 0;
+                break;
+            default: _token_push(stream, c); break;
+            }
+            continue;
+
+        case AXION_LEX_STRING_UNICODE: {
+            i++;
+            unsigned v;
+            if (c >= '0' && c <= '9') v = (unsigned)(c - '0');
+            else if (c >= 'a' && c <= 'f') v = (unsigned)(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') v = (unsigned)(c - 'A' + 10);
+            else return _fail(stream, "Malformed JSON in streamed response (bad unicode escape).");
+            stream->ucode = (stream->ucode << 4) | v;
+            if (++stream->uhex == 4) {
+                _token_push_utf8(stream, stream->ucode);
+                stream->lex = AXION_LEX_STRING;
+            }
+            continue;
+        }
+
+        case AXION_LEX_NUMBER:
+            if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+                _token_push(stream, c);
+                i++;
+                continue;
+            }
+            stream->lex = AXION_LEX_NONE;
+            _on_scalar(stream, 0);
+            break; // Re-examine c as a structural character
+
+        case AXION_LEX_LITERAL:
+            if (c >= 'a' && c <= 'z') {
+                i++;
+                continue;
+            }
+            // true/false/null never carry a bar field
+            stream->lex = AXION_LEX_NONE;
+            stream->key_field = -1;
+            break;
+
+        case AXION_LEX_NONE:
+            break;
+        }
+
+        i++;
+        switch (c) {
+        case ' ': case '\t': case '\n': case '\r': case ',':
+            if (c == ',' && stream->depth > 0 && stream->stack[stream->depth - 1] == '{') {
+                stream->expect_key = 1;
+            }
+            break;
+        case ':':
+            stream->expect_key = 0;
+            break;
+        case '{':
+        case '[':
+            if (stream->depth == AXION_STREAM_MAX_DEPTH) {
+                return _fail(stream, "Streamed response is nested too deeply.");
+            }
+            stream->stack[stream->depth] = c;
+            if (c == '{') {
+                stream->acc[stream->depth].fields = 0;
+                stream->expect_key = 1;
+            }
+            stream->depth++;
+            stream->key_field = -1;
+            break;
+        case '}':
+        case ']':
+            if (stream->depth == 0 || stream->stack[stream->depth - 1] != (c == '}' ? '{' : '[')) {
+                return _fail(stream, "Malformed JSON in streamed response (unbalanced brackets).");
+            }
+            stream->depth--;
+            stream->expect_key = 0;
+            stream->key_field = -1;
+            if (c == '}' && _on_object_end(stream, &stream->acc[stream->depth])) return 1;
+            break;
+        case '"':
+            stream->lex = AXION_LEX_STRING;
+            stream->token_len = 0;
+            stream->token_overflow = 0;
+            break;
+        case 't': case 'f': case 'n':
+            stream->lex = AXION_LEX_LITERAL;
+            break;
+        default:
+            if ((c >= '0' && c <= '9') || c == '-') {
+                stream->lex = AXION_LEX_NUMBER;
+                stream->token_len = 0;
+                stream->token_overflow = 0;
+                _token_push(stream, c);
+            } else {
+                return _fail(stream, "Malformed JSON in streamed response (unexpected character).");
+            }
+            break;
+        }
+    }
+    return 0;
+}
+
+const char* _axion_bar_stream_finish(void *ctx) {
+    AxionBarStream *stream = (AxionBarStream *)ctx;
+    if (stream->error) return stream->error;
+    if (stream->depth != 0 || stream->lex == AXION_LEX_STRING ||
+        stream->lex == AXION_LEX_STRING_ESCAPE || stream->lex == AXION_LEX_STRING_UNICODE) {
+        return "Truncated JSON in streamed response.";
+    }
+    return NULL;
+}
+
+// ---------------------------------------------------------------------
+// Streaming price endpoints
+// ---------------------------------------------------------------------
+AxionResponse* _axion_prices_sink(AxionClient *client, const char *market, const char *ticker,
+                                  const char *from_date, const char *to_date, const char *frame,
+                                  const AxionSink *sink) {
+    const char *keys[] = {"from", "to", "frame"};
+    const char *values[] = {from_date, to_date, frame};
+    char *query = _build_query(keys, values, 3);
+    // The market is part of the endpoint template so the ticker stays its first argument
+    char fmt[64];
+    snprintf(fmt, sizeof(fmt), "%s/%%s/prices", market);
+    AxionResponse *resp = _axion_request_sink(client, query, sink, fmt, ticker);
+    free(query);
+    return resp;
+}
+
+static AxionResponse* _prices_stream(AxionClient *client, const char *market, const char *ticker,
+                                     const char *from_date, const char *to_date, const char *frame,
+                                     AxionBarCallback on_bar, void *userdata) {
+    if (!on_bar) return NULL;
+
+    AxionBarStream *stream = malloc(sizeof(AxionBarStream));
+    if (!stream) {
+        fprintf(stderr, "error: failed to allocate memory for stream.\n");
+        return NULL;
+    }
+    _axion_bar_stream_init(stream, on_bar, userdata);
+
+    AxionSink sink = { _axion_bar_stream_write, _axion_bar_stream_finish, stream, NULL, 0 };
+    AxionResponse *resp = _axion_prices_sink(client, market, ticker, from_date, to_date, frame, &sink);
+    free(stream);
+    return resp;
+}
+
+AxionResponse* axion_stocks_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata) {
+    return _prices_stream(client, "stocks", ticker, from_date, to_date, frame, on_bar, userdata);
+}
+
+AxionResponse* axion_etfs_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata) {
+    return _prices_stream(client, "etfs", ticker, from_date, to_date, frame, on_bar, userdata);
+}
+
+AxionResponse* axion_crypto_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata) {
+    return _prices_stream(client, "crypto", ticker, from_date, to_date, frame, on_bar, userdata);
+}
+
+AxionResponse* axion_forex_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata) {
+    return _prices_stream(client, "forex", ticker, from_date, to_date, frame, on_bar, userdata);
+}
+
+AxionResponse* axion_futures_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata) {
+    return _prices_stream(client, "futures", ticker, from_date, to_date, frame, on_bar, userdata);
+}
+
+AxionResponse* axion_indices_prices_stream(AxionClient *client, const char *ticker, const char *from_date, const char *to_date, const char *frame, AxionBarCallback on_bar, void *userdata) {
+    return _prices_stream(client, "indices", ticker, from_date, to_date, frame, on_bar, userdata);
+}
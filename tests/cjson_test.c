@@ -0,0 +1,307 @@
+// Regression tests for the bundled cJSON's number conversion and string scan.
+//
+// Numbers are compared bit for bit with glibc's strtod, which rounds
+// correctly, over hand-picked edge cases and random inputs. Strings are
+// parsed so they end on the last byte of a page followed by an unmapped
+// one, which faults if a vector load reads past the input, and random
+// strings are round-tripped through the printer. 'make check' builds this
+// twice, once with -DCJSON_NO_SIMD, so both scanners are covered.
+
+#define _GNU_SOURCE
+#include "cJSON.h"
+#include <locale.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        if (++failures <= 20) { \
+            fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+            fprintf(stderr, __VA_ARGS__); \
+            fputc('\n', stderr); \
+        } \
+    } \
+} while (0)
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t _rand64(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static uint64_t _bits(double d) {
+    uint64_t u;
+    memcpy(&u, &d, sizeof(u));
+    return u;
+}
+
+// ---------------------------------------------------------------------
+// Numbers
+// ---------------------------------------------------------------------
+static const char *edge_numbers[] = {
+    "0", "-0", "1", "-1", "0.1", "0.2", "0.30000000000000004", "1e23", "8.98846567431158e307",
+    // Subnormals and the normal/subnormal boundary
+    "4.9406564584124654e-324", "5e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+    "1e-320", "2.2250738585072009e-308", "2.2250738585072011e-308", "2.2250738585072014e-308",
+    "2.22507385850720113605740979670913197593481954e-308", "1e-400", "-1e-400",
+    // Overflow and the largest finite value
+    "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308", "1e309", "-1e400",
+    // 19 and 20 digit mantissas, around the uint64_t limit
+    "1234567890123456789", "9999999999999999999", "12345678901234567890", "18446744073709551615",
+    "18446744073709551616", "99999999999999999999", "1.234567890123456789e-5", "12345678901234567890e-30",
+    "0.00000000000000000000000000000012345678901234567890",
+    "9007199254740993123456789", "7.2057594037927933e16",
+    // Exactly halfway between two doubles, and just either side
+    "9007199254740993", "9007199254740995", "9007199254740993.0000000001",
+    "1.00000000000000011102230246251565404236316680908203125",
+    "1.00000000000000011102230246251565404236316680908203124",
+    "1.00000000000000011102230246251565404236316680908203126",
+    "0.500000000000000166533453693773481063544750213623046875",
+    "2.0000000000000002220446049250313080847263336181640625",
+    "9223372036854775807", "9223372036854775808", "9223372036854776832", "9223372036854776833",
+    // Long inputs that take the slow path
+    "3.14159265358979323846264338327950288419716939937510582097494459230781640628620899862803482534211706798",
+    "0.000000000000000000000000000000000000000000000000000000000000000000000000000001e78",
+    "100000000000000000000000000000000000000000000000000000000000000000000000000000e-78",
+};
+
+// Checks one number both through cJSON_ParseDouble and as a whole document
+static void _check_number(const char *text) {
+    double expected = strtod(text, NULL);
+    double actual = 0;
+    size_t len = strlen(text);
+
+    size_t consumed = cJSON_ParseDouble(text, len, &actual);
+    CHECK(consumed == len, "%s: consumed %zu of %zu bytes", text, consumed, len);
+    CHECK(_bits(actual) == _bits(expected), "%s: got %.17g, want %.17g", text, actual, expected);
+
+    cJSON *json = cJSON_ParseWithLength(text, len);
+    if (isinf(expected)) {
+        // The document parser keeps overflow as infinity or rejects it; either is fine
+        CHECK(!json || isinf(json->valuedouble), "%s: document parsed to %.17g", text, json->valuedouble);
+    } else {
+        CHECK(json && cJSON_IsNumber(json), "%s: document did not parse", text);
+        if (json) CHECK(_bits(json->valuedouble) == _bits(expected), "%s: document got %.17g", text, json->valuedouble);
+    }
+    cJSON_Delete(json);
+}
+
+// A random decimal: up to 25 digits with an optional point and exponent
+static void _random_decimal(char *out, size_t size) {
+    size_t n = 0;
+    if (_rand64() & 1) out[n++] = '-';
+    int digits = 1 + (int)(_rand64() % 25);
+    int point = (_rand64() & 1) ? (int)(_rand64() % digits) : -1;
+    int i;
+    for (i = 0; i < digits; i++) {
+        out[n++] = (char)('0' + (i == 0 && digits > 1 ? 1 + _rand64() % 9 : _rand64() % 10));
+        if (i == point) {
+            out[n++] = '.';
+            // A point needs a digit after it
+            if (i == digits - 1) out[n++] = (char)('0' + _rand64() % 10);
+        }
+    }
+    if (_rand64() & 1) snprintf(out + n, size - n, "e%d", (int)(_rand64() % 700) - 350);
+    else out[n] = '\0';
+}
+
+// A random finite double printed with 1 to 17 significant digits, so most
+// land between two doubles and some exactly round-trip
+static void _random_printed(char *out, size_t size) {
+    double d;
+    do {
+        uint64_t u = _rand64();
+        memcpy(&d, &u, sizeof(d));
+    } while (!isfinite(d));
+    snprintf(out, size, "%.*e", (int)(_rand64() % 17), d);
+}
+
+static void _test_numbers(void) {
+    char text[1200];
+    size_t i;
+    for (i = 0; i < sizeof(edge_numbers) / sizeof(edge_numbers[0]); i++) _check_number(edge_numbers[i]);
+
+    // Points exactly halfway between two doubles, printed in full, and the
+    // same points rounded to 20 and 25 digits, which land just beside them.
+    // long double holds the midpoint exactly.
+    for (i = 0; i < 3000; i++) {
+        int e = (int)(_rand64() % 2000) - 1000;
+        double lo = ldexp(1.0 + (double)(_rand64() % (1u << 20)) / (1u << 20), e);
+        double hi = nextafter(lo, INFINITY);
+        if (!isfinite(hi)) continue;
+        long double mid = (long double)lo + ((long double)hi - (long double)lo) / 2;
+        int precision = i % 3 == 0 ? 800 : i % 3 == 1 ? 19 : 24;
+        snprintf(text, sizeof(text), "%.*Le", precision, mid);
+        _check_number(text);
+    }
+
+    for (i = 0; i < 200000; i++) {
+        if (i & 1) _random_decimal(text, sizeof(text));
+        else _random_printed(text, sizeof(text));
+        _check_number(text);
+    }
+}
+
+// Numbers must not depend on the process locale's decimal separator
+static void _test_locale(void) {
+    static const char *locales[] = { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8" };
+    double expected[sizeof(edge_numbers) / sizeof(edge_numbers[0])];
+    size_t i;
+    for (i = 0; i < sizeof(edge_numbers) / sizeof(edge_numbers[0]); i++) expected[i] = strtod(edge_numbers[i], NULL);
+
+    for (i = 0; i < sizeof(locales) / sizeof(locales[0]); i++) {
+        if (setlocale(LC_NUMERIC, locales[i])) break;
+    }
+    if (i == sizeof(locales) / sizeof(locales[0])) {
+        printf("cjson: no comma-decimal locale installed, skipping locale test\n");
+        return;
+    }
+    for (i = 0; i < sizeof(edge_numbers) / sizeof(edge_numbers[0]); i++) {
+        double actual = 0;
+        cJSON_ParseDouble(edge_numbers[i], strlen(edge_numbers[i]), &actual);
+        CHECK(_bits(actual) == _bits(expected[i]), "%s under %s: got %.17g", edge_numbers[i],
+              setlocale(LC_NUMERIC, NULL), actual);
+    }
+    setlocale(LC_NUMERIC, "C");
+}
+
+// ---------------------------------------------------------------------
+// Strings
+// ---------------------------------------------------------------------
+// Fills content with len bytes of JSON string body and expected with what
+// it decodes to; variant places an escape at a different position
+static size_t _string_body(char *content, char *expected, size_t len, int variant) {
+    size_t n = 0, e = 0;
+    while (n < len) {
+        size_t left = len - n;
+        if (variant == 1 && left >= 2 && n % 17 == 3) {
+            memcpy(content + n, "\\n", 2);
+            n += 2;
+            expected[e++] = '\n';
+        } else if (variant == 2 && left >= 2 && n % 33 == 31) {
+            memcpy(content + n, "\\\"", 2);
+            n += 2;
+            expected[e++] = '"';
+        } else if (variant == 3 && left >= 6 && n % 29 == 15) {
+            memcpy(content + n, "\\u00e9", 6);
+            n += 6;
+            expected[e++] = (char)0xc3;
+            expected[e++] = (char)0xa9;
+        } else {
+            char c = (char)('a' + (n % 26));
+            content[n++] = c;
+            expected[e++] = c;
+        }
+    }
+    expected[e] = '\0';
+    return n;
+}
+
+static void _test_page_boundary(void) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *map = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED || mprotect(map + page, page, PROT_NONE) != 0) {
+        printf("cjson: cannot map a guard page, skipping page boundary test\n");
+        return;
+    }
+    char *page_end = map + page;
+    char content[512], expected[512];
+    size_t len;
+    int variant;
+
+    for (variant = 0; variant < 4; variant++) {
+        for (len = 0; len < 200; len++) {
+            size_t body = _string_body(content, expected, len, variant);
+
+            // A bare string whose closing quote is the page's last byte
+            char *doc = page_end - (body + 2);
+            doc[0] = '"';
+            memcpy(doc + 1, content, body);
+            doc[body + 1] = '"';
+            cJSON *json = cJSON_ParseWithLength(doc, body + 2);
+            CHECK(json && cJSON_IsString(json) && strcmp(json->valuestring, expected) == 0,
+                  "string of %zu bytes (variant %d) at page end", body, variant);
+            cJSON_Delete(json);
+
+            // An unterminated string running into the page end must fail cleanly
+            json = cJSON_ParseWithLength(doc, body + 1);
+            CHECK(!json, "unterminated string of %zu bytes (variant %d) parsed", body, variant);
+            cJSON_Delete(json);
+
+            // Trailing whitespace up to the page end, for the whitespace skip
+            size_t pad = len % 40;
+            doc = page_end - (body + 8 + pad);
+            memcpy(doc, "{\"k\":\"", 6);
+            memcpy(doc + 6, content, body);
+            memcpy(doc + 6 + body, "\"}", 2);
+            memset(doc + 8 + body, (len & 1) ? ' ' : '\n', pad);
+            json = cJSON_ParseWithLength(doc, body + 8 + pad);
+            const cJSON *k = cJSON_GetObjectItem(json, "k");
+            CHECK(cJSON_IsString(k) && strcmp(k->valuestring, expected) == 0,
+                  "object with %zu byte string and %zu trailing spaces at page end", body, pad);
+            cJSON_Delete(json);
+        }
+    }
+
+    // Whitespace alone up to the page end is not a document
+    for (len = 1; len < 100; len++) {
+        memset(page_end - len, ' ', len);
+        cJSON *json = cJSON_ParseWithLength(page_end - len, len);
+        CHECK(!json, "%zu spaces parsed as a document", len);
+        cJSON_Delete(json);
+    }
+    munmap(map, 2 * page);
+}
+
+// Random strings with quotes, backslashes, control and multi-byte
+// characters must come back unchanged through the printer and parser
+static void _test_round_trip(void) {
+    static const char *pieces[] = { "\"", "\\", "/", "\n", "\t", "\x01", "\x1f", " ", "\xc3\xa9", "\xe2\x82\xac",
+                                    "\xf0\x9f\x98\x80", "plain text" };
+    char text[1024];
+    int i;
+    for (i = 0; i < 20000; i++) {
+        size_t n = 0;
+        size_t target = (size_t)(_rand64() % 300);
+        while (n < target) {
+            const char *piece = (_rand64() % 4) ? "abcdefghijklmnop" + _rand64() % 16
+                                                : pieces[_rand64() % (sizeof(pieces) / sizeof(pieces[0]))];
+            size_t len = strlen(piece);
+            if (n + len >= sizeof(text)) break;
+            memcpy(text + n, piece, len);
+            n += len;
+        }
+        text[n] = '\0';
+
+        cJSON *item = cJSON_CreateString(text);
+        char *printed = cJSON_PrintUnformatted(item);
+        cJSON *parsed = printed ? cJSON_Parse(printed) : NULL;
+        CHECK(cJSON_IsString(parsed) && strcmp(parsed->valuestring, text) == 0, "round trip of %s", printed);
+        cJSON_Delete(parsed);
+        cJSON_free(printed);
+        cJSON_Delete(item);
+    }
+}
+
+int main(void) {
+    _test_numbers();
+    _test_locale();
+    _test_page_boundary();
+    _test_round_trip();
+    if (failures) {
+        fprintf(stderr, "cjson: %d failures\n", failures);
+        return 1;
+    }
+    printf("cjson: ok\n");
+    return 0;
+}
@@ -0,0 +1,252 @@
+// Tests for the typed fundamentals decoders, run offline by 'make check'.
+//
+// Every field of the recorded fixtures in tools/fixtures is decoded and
+// compared with a plain cJSON lookup of its key, so a field whose key or
+// offset is wrong in a schema shows up here. The rest covers key spellings,
+// empty and malformed payloads and integer fields out of range.
+
+#include "axion.h"
+#include "cJSON.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        failures++; \
+        fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fputc('\n', stderr); \
+    } \
+} while (0)
+
+static cJSON* _load(const char *file) {
+    FILE *f = fopen(file, "rb");
+    if (!f) {
+        fprintf(stderr, "FAIL cannot open %s; run from the repository root\n", file);
+        failures++;
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *text = malloc((size_t)len);
+    cJSON *json = NULL;
+    if (text && fread(text, 1, (size_t)len, f) == (size_t)len) json = cJSON_ParseWithLength(text, (size_t)len);
+    free(text);
+    fclose(f);
+    CHECK(json, "%s does not parse", file);
+    return json;
+}
+
+// The value a field should decode to, looked up the slow way
+static double _expected(const cJSON *obj, const char *key) {
+    const cJSON *item = cJSON_GetObjectItemCaseSensitive(obj, key);
+    if (cJSON_IsNumber(item)) return item->valuedouble;
+    if (cJSON_IsString(item)) return strtod(item->valuestring, NULL);
+    return NAN;
+}
+
+static int _same(double a, double b) {
+    return (isnan(a) && isnan(b)) || a == b;
+}
+
+#define CHECK_FIELD(member, key) \
+    CHECK(_same(record->member, _expected(obj, key)), "%s: %s is %g, want %g", name, key, record->member, \
+          _expected(obj, key));
+
+static void _check_fiscal(const char *name, const AxionFiscalPeriod *fiscal, const cJSON *obj) {
+    const cJSON *date = cJSON_GetObjectItemCaseSensitive(obj, "date");
+    const cJSON *period = cJSON_GetObjectItemCaseSensitive(obj, "period");
+    const cJSON *year = cJSON_GetObjectItemCaseSensitive(obj, "fiscalYear");
+    CHECK(strcmp(fiscal->date, cJSON_IsString(date) ? date->valuestring : "") == 0, "%s: date is %s", name, fiscal->date);
+    CHECK(strcmp(fiscal->period, cJSON_IsString(period) ? period->valuestring : "") == 0, "%s: period is %s", name,
+          fiscal->period);
+    CHECK(fiscal->year == (cJSON_IsNumber(year) ? year->valueint : 0), "%s: year is %d", name, fiscal->year);
+}
+
+// ---------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------
+static void _test_balance_sheets(void) {
+    cJSON *json = _load("tools/fixtures/financials/statements/_/balance.json");
+    const cJSON *list = cJSON_GetObjectItemCaseSensitive(json, "data");
+    int count = cJSON_GetArraySize(list);
+    AxionBalanceSheet sheets[16];
+    CHECK(count > 0 && count <= 16, "balance fixture holds %d statements", count);
+    CHECK(axion_decode_balance_sheets(json, sheets, 16) == count, "balance sheets: wrong count");
+
+    const char *name = "balance sheet";
+    int i;
+    for (i = 0; i < count && i < 16; i++) {
+        const cJSON *obj = cJSON_GetArrayItem(list, i);
+        const AxionBalanceSheet *record = &sheets[i];
+        _check_fiscal(name, &record->fiscal, obj);
+        AXION_BALANCE_SHEET_FIELDS(CHECK_FIELD)
+    }
+    cJSON_Delete(json);
+}
+
+static void _test_income_statements(void) {
+    cJSON *json = _load("tools/fixtures/financials/statements/_/income.json");
+    const cJSON *list = cJSON_GetObjectItemCaseSensitive(json, "data");
+    int count = cJSON_GetArraySize(list);
+    AxionIncomeStatement statements[16];
+    CHECK(count > 0 && count <= 16, "income fixture holds %d statements", count);
+    CHECK(axion_decode_income_statements(json, statements, 16) == count, "income statements: wrong count");
+
+    const char *name = "income statement";
+    int i;
+    for (i = 0; i < count && i < 16; i++) {
+        const cJSON *obj = cJSON_GetArrayItem(list, i);
+        const AxionIncomeStatement *record = &statements[i];
+        _check_fiscal(name, &record->fiscal, obj);
+        AXION_INCOME_STATEMENT_FIELDS(CHECK_FIELD)
+    }
+    cJSON_Delete(json);
+}
+
+static void _test_cash_flow_statements(void) {
+    cJSON *json = _load("tools/fixtures/financials/statements/_/cashflow.json");
+    const cJSON *list = cJSON_GetObjectItemCaseSensitive(json, "data");
+    int count = cJSON_GetArraySize(list);
+    AxionCashFlowStatement statements[16];
+    CHECK(count > 0 && count <= 16, "cash flow fixture holds %d statements", count);
+    CHECK(axion_decode_cash_flow_statements(json, statements, 16) == count, "cash flow statements: wrong count");
+
+    const char *name = "cash flow statement";
+    int i;
+    for (i = 0; i < count && i < 16; i++) {
+        const cJSON *obj = cJSON_GetArrayItem(list, i);
+        const AxionCashFlowStatement *record = &statements[i];
+        _check_fiscal(name, &record->fiscal, obj);
+        AXION_CASH_FLOW_STATEMENT_FIELDS(CHECK_FIELD)
+    }
+    cJSON_Delete(json);
+}
+
+static void _test_metrics(void) {
+    cJSON *json = _load("tools/fixtures/financials/_/metrics.json");
+    const cJSON *obj = cJSON_GetObjectItemCaseSensitive(json, "data");
+    AxionMetrics metrics;
+    const AxionMetrics *record = &metrics;
+    const char *name = "metrics";
+    CHECK(axion_decode_metrics(json, &metrics) == 0, "metrics did not decode");
+    AXION_METRICS_FIELDS(CHECK_FIELD)
+    cJSON_Delete(json);
+}
+
+static void _test_snapshot(void) {
+    cJSON *json = _load("tools/fixtures/financials/_/snapshot.json");
+    const cJSON *obj = cJSON_GetObjectItemCaseSensitive(json, "data");
+    AxionSnapshot snapshot;
+    const AxionSnapshot *record = &snapshot;
+    const char *name = "snapshot";
+    CHECK(axion_decode_snapshot(json, &snapshot) == 0, "snapshot did not decode");
+    AXION_SNAPSHOT_FIELDS(CHECK_FIELD)
+    cJSON_Delete(json);
+}
+
+// ---------------------------------------------------------------------
+// Edge cases
+// ---------------------------------------------------------------------
+static void _test_counts(void) {
+    cJSON *json = cJSON_Parse("[{\"totalAssets\":1},{\"totalAssets\":2},7,{\"totalAssets\":3}]");
+    AxionBalanceSheet sheets[2];
+    // Like axion_stats(), the count is the payload's, however many were written
+    CHECK(axion_decode_balance_sheets(json, NULL, 0) == 3, "counting without output");
+    CHECK(axion_decode_balance_sheets(json, sheets, 2) == 3, "count with a short output");
+    CHECK(sheets[0].total_assets == 1 && sheets[1].total_assets == 2, "records out of order");
+    cJSON_Delete(json);
+
+    json = cJSON_Parse("{\"data\":{\"fiscalYear\":2021,\"totalAssets\":5}}");
+    CHECK(axion_decode_balance_sheets(json, sheets, 2) == 1, "single object counts as one statement");
+    CHECK(sheets[0].fiscal.year == 2021 && sheets[0].total_assets == 5, "single object decoded wrong");
+    cJSON_Delete(json);
+}
+
+static void _test_empty(void) {
+    AxionBalanceSheet sheet;
+    AxionMetrics metrics;
+    AxionSnapshot snapshot;
+
+    cJSON *json = cJSON_Parse("{\"data\":[]}");
+    CHECK(axion_decode_balance_sheets(json, &sheet, 1) == 0, "empty list holds statements");
+    CHECK(axion_decode_metrics(json, &metrics) == -1, "empty list decoded as metrics");
+    CHECK(axion_decode_snapshot(json, &snapshot) == -1, "empty list decoded as a snapshot");
+    CHECK(isnan(metrics.market_cap) && isnan(snapshot.price), "failed decode left fields set");
+    cJSON_Delete(json);
+
+    json = cJSON_Parse("\"not an object\"");
+    CHECK(axion_decode_balance_sheets(json, &sheet, 1) == -1, "string decoded as statements");
+    CHECK(axion_decode_metrics(json, &metrics) == -1, "string decoded as metrics");
+    cJSON_Delete(json);
+
+    CHECK(axion_decode_balance_sheets(NULL, &sheet, 1) == -1, "NULL decoded as statements");
+    CHECK(axion_decode_snapshot(NULL, &snapshot) == -1, "NULL decoded as a snapshot");
+}
+
+static void _test_values(void) {
+    AxionBalanceSheet sheet;
+    cJSON *json = cJSON_Parse("{\"total_assets\":\"12.5\",\"TotalLiabilities\":null,\"inventory\":true,"
+                              "\"date\":\"2024-09-28T00:00:00.000Z\",\"unknownKey\":1}");
+    CHECK(axion_decode_balance_sheets(json, &sheet, 1) == 1, "values did not decode");
+    CHECK(sheet.total_assets == 12.5, "numeric string or member name not accepted: %g", sheet.total_assets);
+    CHECK(isnan(sheet.total_liabilities) && isnan(sheet.inventory), "non-numbers are not NAN");
+    CHECK(isnan(sheet.cash_and_equivalents), "absent field is not NAN");
+    CHECK(strcmp(sheet.fiscal.date, "2024-09-28T00:0") == 0, "long date not cut to fit: %s", sheet.fiscal.date);
+    CHECK(sheet.fiscal.period[0] == '\0' && sheet.fiscal.year == 0, "absent fiscal fields are set");
+    cJSON_Delete(json);
+}
+
+// fiscalYear values an int cannot hold leave the field 0
+static void _test_integer_range(void) {
+    static const struct {
+        const char *json;
+        int year;
+    } cases[] = {
+        { "{\"fiscalYear\":2024}", 2024 },
+        { "{\"fiscalYear\":2024.0}", 2024 },
+        { "{\"fiscalYear\":\"2023\"}", 2023 },
+        { "{\"fiscalYear\":-2147483648}", -2147483647 - 1 },
+        { "{\"fiscalYear\":2147483647}", 2147483647 },
+        { "{\"fiscalYear\":2147483648}", 0 },
+        { "{\"fiscalYear\":-2147483649}", 0 },
+        { "{\"fiscalYear\":1e20}", 0 },
+        { "{\"fiscalYear\":-1e300}", 0 },
+        { "{\"fiscalYear\":1e400}", 0 },
+        { "{\"fiscalYear\":\"inf\"}", 0 },
+        { "{\"fiscalYear\":\"nan\"}", 0 },
+        { "{\"fiscalYear\":\"FY\"}", 0 },
+    };
+    size_t i;
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        AxionIncomeStatement statement;
+        cJSON *json = cJSON_Parse(cases[i].json);
+        CHECK(axion_decode_income_statements(json, &statement, 1) == 1, "%s did not decode", cases[i].json);
+        CHECK(statement.fiscal.year == cases[i].year, "%s: year is %d, want %d", cases[i].json, statement.fiscal.year,
+              cases[i].year);
+        cJSON_Delete(json);
+    }
+}
+
+int main(void) {
+    _test_balance_sheets();
+    _test_income_statements();
+    _test_cash_flow_statements();
+    _test_metrics();
+    _test_snapshot();
+    _test_counts();
+    _test_empty();
+    _test_values();
+    _test_integer_range();
+    if (failures) {
+        fprintf(stderr, "fundamentals: %d failures\n", failures);
+        return 1;
+    }
+    printf("fundamentals: ok\n");
+    return 0;
+}
@@ -0,0 +1,165 @@
+// Tests for list iterators, run offline by 'make check'.
+//
+// A small HTTP server on a thread of this process sends a list much larger
+// than the iterator's prefetch queue, so the download has to wait for the
+// caller. The caller then pauses for longer than the client's stall and
+// total timeouts, which must not end the download.
+
+#include "axion.h"
+#include "cJSON.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LIST_ITEMS 60000    // About 6 MB, several times the prefetch queue
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        failures++; \
+        fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fputc('\n', stderr); \
+    } \
+} while (0)
+
+static int listener = -1;
+static char *list_body = NULL;
+static size_t list_size = 0;
+
+static void _sleep_ms(long ms) {
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+    while (nanosleep(&ts, &ts) != 0) {}
+}
+
+static void _build_list(void) {
+    size_t cap = (size_t)LIST_ITEMS * 128;
+    list_body = malloc(cap);
+    size_t n = (size_t)snprintf(list_body, cap, "{\"data\":[");
+    int i;
+    for (i = 0; i < LIST_ITEMS; i++) {
+        n += (size_t)snprintf(list_body + n, cap - n,
+                              "%s{\"ticker\":\"T%05d\",\"name\":\"Test company %05d with a longer name\",\"exchange\":\"X\"}",
+                              i ? "," : "", i, i);
+    }
+    n += (size_t)snprintf(list_body + n, cap - n, "]}");
+    list_size = n;
+}
+
+// Answers one request per connection with the whole list
+static void* _serve(void *arg) {
+    (void)arg;
+    for (;;) {
+        int fd = accept(listener, NULL, NULL);
+        if (fd < 0) return NULL;
+        char request[4096];
+        size_t have = 0;
+        while (have < sizeof(request) - 1) {
+            ssize_t r = recv(fd, request + have, sizeof(request) - 1 - have, 0);
+            if (r <= 0) break;
+            have += (size_t)r;
+            request[have] = '\0';
+            if (strstr(request, "\r\n\r\n")) break;
+        }
+        char header[128];
+        int len = snprintf(header, sizeof(header),
+                           "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n"
+                           "Connection: close\r\n\r\n", list_size);
+        send(fd, header, (size_t)len, MSG_NOSIGNAL);
+        size_t sent = 0;
+        while (sent < list_size) {
+            ssize_t w = send(fd, list_body + sent, list_size - sent, MSG_NOSIGNAL);
+            if (w <= 0) break;
+            sent += (size_t)w;
+        }
+        close(fd);
+    }
+}
+
+static int _start_server(char *base_url, size_t size) {
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0 || bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listener, 4) != 0 ||
+        getsockname(listener, (struct sockaddr *)&addr, &addr_len) != 0) {
+        return -1;
+    }
+    snprintf(base_url, size, "http://127.0.0.1:%d", ntohs(addr.sin_port));
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, _serve, NULL) != 0) return -1;
+    pthread_detach(thread);
+    return 0;
+}
+
+// A caller slower than the stall window still gets every item
+static void _test_slow_consumer(const char *base_url) {
+    AxionClient *client = axion_init("test");
+    axion_set_base_url(client, base_url);
+    axion_set_timeouts(client, -1, 1000, 1000);
+
+    AxionIterator *it = axion_stocks_tickers_iter(client, NULL, NULL);
+    CHECK(it, "iterator did not open");
+    if (!it) {
+        axion_client(client);
+        return;
+    }
+    int count = 0;
+    int in_order = 1;
+    cJSON *item;
+    while ((item = axion_iter_next(it))) {
+        const cJSON *ticker = cJSON_GetObjectItemCaseSensitive(item, "ticker");
+        char expected[16];
+        snprintf(expected, sizeof(expected), "T%05d", count);
+        if (!cJSON_IsString(ticker) || strcmp(ticker->valuestring, expected) != 0) in_order = 0;
+        // Long enough for the queue to fill and the stall and total timeouts to pass
+        if (count == 0) _sleep_ms(2500);
+        count++;
+    }
+    CHECK(axion_iter_error(it) == NULL, "slow consumer ended with: %s", axion_iter_error(it));
+    CHECK(count == LIST_ITEMS, "slow consumer got %d of %d items", count, LIST_ITEMS);
+    CHECK(in_order, "items arrived out of order");
+    CHECK(axion_iter_status(it) == 200, "status is %d", axion_iter_status(it));
+    axion_iter_free(it);
+    axion_client(client);
+}
+
+// Freeing an iterator part way through stops the download
+static void _test_early_free(const char *base_url) {
+    AxionClient *client = axion_init("test");
+    axion_set_base_url(client, base_url);
+
+    AxionIterator *it = axion_stocks_tickers_iter(client, NULL, NULL);
+    CHECK(it && axion_iter_next(it), "no first item");
+    axion_iter_free(it);
+    axion_client(client);
+}
+
+int main(void) {
+    char base_url[64];
+    _build_list();
+    if (_start_server(base_url, sizeof(base_url)) != 0) {
+        fprintf(stderr, "FAIL cannot listen on the loopback interface\n");
+        return 1;
+    }
+    axion_global_init();
+    _test_slow_consumer(base_url);
+    _test_early_free(base_url);
+    axion_global_cleanup();
+    if (failures) {
+        fprintf(stderr, "iter: %d failures\n", failures);
+        return 1;
+    }
+    printf("iter: ok\n");
+    return 0;
+}
@@ -0,0 +1,394 @@
+// Local stand-in for the Axion API, for benchmarks and offline tests.
+//
+// Serves GET requests over plain HTTP/1.1 with keep-alive. A request for
+// /stocks/AAPL/prices is answered from the first fixture file that exists
+// among
+//
+//     <dir>/stocks/AAPL/prices.json
+//     <dir>/_/AAPL/prices.json, <dir>/stocks/_/prices.json, ...
+//
+// where "_" stands for any one path segment. Without a fixture, prices,
+// holdings, transcript and quote endpoints get a generated body whose size
+// is set with -n; anything else is a 404. Bodies are built once and kept,
+// so the server's own cost per request stays small and constant.
+//
+// Point a client at it with axion_set_base_url(client, "http://127.0.0.1:8080").
+
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MOCK_MAX_REQUEST 8192
+
+typedef struct {
+    int port;
+    const char *dir;
+    int latency_ms;     // Added before every response
+    int jitter_ms;      // Plus a uniformly random extra of up to this much
+    int records;        // Bars, holdings or paragraphs in generated bodies
+} MockConfig;
+
+static MockConfig config = { 8080, "tools/fixtures", 0, 0, 1000 };
+
+// Response bodies, loaded or generated on first use and kept for good
+typedef struct MockBody {
+    struct MockBody *next;
+    char *key;
+    int status;
+    char *data;
+    size_t size;
+} MockBody;
+
+static MockBody *bodies = NULL;
+static pthread_mutex_t bodies_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Unknown paths all get this body; caching one per path would let clients
+// grow the table without bound
+static char not_found_text[] = "{\"message\":\"Not found\"}";
+static MockBody not_found = { NULL, NULL, 404, not_found_text, sizeof(not_found_text) - 1 };
+
+// ---------------------------------------------------------------------
+// Growable text buffer for generated bodies
+// ---------------------------------------------------------------------
+typedef struct {
+    char *data;
+    size_t size;
+    size_t capacity;
+} MockText;
+
+static void _text_printf(MockText *text, const char *fmt, ...) {
+    for (;;) {
+        va_list ap;
+        va_start(ap, fmt);
+        size_t room = text->capacity - text->size;
+        int n = vsnprintf(text->data ? text->data + text->size : NULL, room, fmt, ap);
+        va_end(ap);
+        if (n < 0) return;
+        if ((size_t)n < room) {
+            text->size += (size_t)n;
+            return;
+        }
+        size_t capacity = text->capacity ? text->capacity * 2 : 4096;
+        while (capacity - text->size <= (size_t)n) capacity *= 2;
+        char *data = realloc(text->data, capacity);
+        if (!data) {
+            fprintf(stderr, "error: out of memory.\n");
+            exit(1);
+        }
+        text->data = data;
+        text->capacity = capacity;
+    }
+}
+
+// Deterministic, so every run serves byte-identical bodies
+static double _random_unit(unsigned *state) {
+    *state = *state * 1103515245u + 12345u;
+    return (double)((*state >> 8) & 0xffffff) / (double)0x1000000;
+}
+
+static void _generate_prices(MockText *text) {
+    unsigned state = 1;
+    double close = 100.0;
+    int i;
+    _text_printf(text, "{\"data\":[");
+    for (i = 0; i < config.records; i++) {
+        double open = close;
+        close = open * (1.0 + (_random_unit(&state) - 0.5) * 0.04);
+        double high = (open > close ? open : close) * (1.0 + _random_unit(&state) * 0.01);
+        double low = (open < close ? open : close) * (1.0 - _random_unit(&state) * 0.01);
+        // One bar per day from 2000-01-01
+        time_t day = (time_t)946684800 + (time_t)i * 86400;
+        struct tm tm;
+        gmtime_r(&day, &tm);
+        _text_printf(text, "%s{\"date\":\"%04d-%02d-%02d\",\"open\":%.4f,\"high\":%.4f,\"low\":%.4f,"
+                     "\"close\":%.4f,\"volume\":%d}", i ? "," : "", tm.tm_year + 1900, tm.tm_mon + 1,
+                     tm.tm_mday, open, high, low, close, 100000 + (int)(_random_unit(&state) * 9900000));
+    }
+    _text_printf(text, "]}");
+}
+
+static void _generate_holdings(MockText *text) {
+    unsigned state = 2;
+    int i;
+    _text_printf(text, "{\"data\":[");
+    for (i = 0; i < config.records; i++) {
+        double weight = _random_unit(&state) * 2.0;
+        _text_printf(text, "%s{\"symbol\":\"H%05d\",\"name\":\"Holding %d Corporation\",\"weight\":%.6f,"
+                     "\"shares\":%d,\"marketValue\":%.2f,\"sector\":\"Sector %d\"}", i ? "," : "", i, i,
+                     weight, 1000 + (int)(_random_unit(&state) * 1000000), weight * 1e7, i % 11);
+    }
+    _text_printf(text, "]}");
+}
+
+static void _generate_transcript(MockText *text) {
+    static const char *sentence = "Revenue grew on strong demand across every region and margins "
+                                  "expanded as we kept a close eye on costs. ";
+    unsigned state = 3;
+    int i, s;
+    _text_printf(text, "{\"data\":{\"year\":2024,\"quarter\":1,\"content\":[");
+    for (i = 0; i < config.records; i++) {
+        _text_printf(text, "%s{\"speaker\":\"Speaker %d\",\"text\":\"", i ? "," : "", i % 7);
+        int sentences = 2 + (int)(_random_unit(&state) * 6);
+        for (s = 0; s < sentences; s++) _text_printf(text, "%s", sentence);
+        _text_printf(text, "\"}");
+    }
+    _text_printf(text, "]}}");
+}
+
+static void _generate_quote(MockText *text) {
+    _text_printf(text, "{\"data\":{\"price\":187.44,\"change\":1.32,\"changePercent\":0.71,\"open\":186.1,"
+                 "\"high\":188.02,\"low\":185.77,\"previousClose\":186.12,\"volume\":48213077,"
+                 "\"timestamp\":1704214800}}");
+}
+
+// ---------------------------------------------------------------------
+// Routing
+// ---------------------------------------------------------------------
+static int _ends_with(const char *path, const char *suffix) {
+    size_t len = strlen(path), n = strlen(suffix);
+    return len >= n && strcmp(path + len - n, suffix) == 0;
+}
+
+static const struct {
+    const char *suffix;
+    void (*make)(MockText *text);
+} generators[] = {
+    { "/prices", _generate_prices },
+    { "/holdings", _generate_holdings },
+    { "/holdings/all", _generate_holdings },
+    { "/transcript", _generate_transcript },
+    { "/quote", _generate_quote },
+};
+
+static int _file_exists(const char *file) {
+    return access(file, R_OK) == 0;
+}
+
+// Finds the fixture for a path, trying it as is and then with each
+// segment in turn replaced by "_"; returns 0 and fills file if found
+// True if any segment of path is "..", which would climb out of the fixture directory
+static int _has_parent_segment(const char *path) {
+    const char *segment = path;
+    for (;;) {
+        const char *end = strchr(segment, '/');
+        size_t len = end ? (size_t)(end - segment) : strlen(segment);
+        if (len == 2 && segment[0] == '.' && segment[1] == '.') return 1;
+        if (!end) return 0;
+        segment = end + 1;
+    }
+}
+
+static int _fixture_for(const char *path, char *file, size_t size) {
+    if (_has_parent_segment(path)) return -1;
+    snprintf(file, size, "%s%s.json", config.dir, path);
+    if (_file_exists(file)) return 0;
+
+    const char *segment = path;
+    while (segment && *segment == '/') {
+        const char *end = strchr(segment + 1, '/');
+        snprintf(file, size, "%s%.*s/_%s.json", config.dir, (int)(segment - path), path, end ? end : "");
+        if (_file_exists(file)) return 0;
+        segment = end;
+    }
+    return -1;
+}
+
+static char* _read_file(const char *file, size_t *size) {
+    FILE *f = fopen(file, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *data = len >= 0 ? malloc((size_t)len + 1) : NULL;
+    if (data && fread(data, 1, (size_t)len, f) != (size_t)len) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    if (data) *size = (size_t)len;
+    return data;
+}
+
+// Returns the cached body for a key, building it with make() the first time
+static MockBody* _body(const char *key, const char *path, void (*make)(MockText *), const char *file) {
+    pthread_mutex_lock(&bodies_lock);
+    MockBody *body;
+    for (body = bodies; body; body = body->next) {
+        if (strcmp(body->key, key) == 0) break;
+    }
+    if (!body) {
+        body = calloc(1, sizeof(MockBody));
+        body->key = strdup(key);
+        body->status = 200;
+        if (file) {
+            body->data = _read_file(file, &body->size);
+        } else if (make) {
+            MockText text = { NULL, 0, 0 };
+            make(&text);
+            body->data = text.data;
+            body->size = text.size;
+        }
+        if (!body->data) {
+            MockText text = { NULL, 0, 0 };
+            _text_printf(&text, "{\"message\":\"No fixture for %s\"}", path);
+            body->status = 404;
+            body->data = text.data;
+            body->size = text.size;
+        }
+        body->next = bodies;
+        bodies = body;
+    }
+    pthread_mutex_unlock(&bodies_lock);
+    return body;
+}
+
+static MockBody* _route(const char *path) {
+    char file[4096];
+    if (_fixture_for(path, file, sizeof(file)) == 0) return _body(file, path, NULL, file);
+
+    size_t i;
+    for (i = 0; i < sizeof(generators) / sizeof(generators[0]); i++) {
+        // Every ticker shares one generated body per kind
+        if (_ends_with(path, generators[i].suffix)) return _body(generators[i].suffix, path, generators[i].make, NULL);
+    }
+    return &not_found;
+}
+
+// ---------------------------------------------------------------------
+// Connections
+// ---------------------------------------------------------------------
+static int _send_all(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        data += n;
+        size -= (size_t)n;
+    }
+    return 0;
+}
+
+static void _sleep_ms(long ms) {
+    if (ms <= 0) return;
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000 };
+    while (nanosleep(&ts, &ts) != 0) {}
+}
+
+static void* _serve(void *arg) {
+    int fd = (int)(intptr_t)arg;
+    unsigned seed = (unsigned)fd ^ (unsigned)time(NULL);
+    char request[MOCK_MAX_REQUEST + 1];
+    size_t have = 0;
+
+    for (;;) {
+        // Read until the end of the request head; GETs carry no body
+        char *end;
+        request[have] = 0;
+        while (!(end = strstr(request, "\r\n\r\n"))) {
+            if (have == MOCK_MAX_REQUEST) goto done;
+            ssize_t n = recv(fd, request + have, MOCK_MAX_REQUEST - have, 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) goto done;
+            have += (size_t)n;
+            request[have] = 0;
+        }
+        size_t head = (size_t)(end - request) + 4;
+
+        char method[16], target[2048];
+        if (sscanf(request, "%15s %2047s", method, target) != 2) goto done;
+        char *query = strchr(target, '?');
+        if (query) *query = 0;
+        end[2] = 0;
+        int close_after = strcasestr(request, "\r\nConnection: close") != NULL;
+
+        MockBody *body = strcmp(method, "GET") == 0 ? _route(target) : NULL;
+        long delay = config.latency_ms;
+        if (config.jitter_ms > 0) delay += rand_r(&seed) % (config.jitter_ms + 1);
+        _sleep_ms(delay);
+
+        char header[256];
+        int n = snprintf(header, sizeof(header),
+                         "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n%s\r\n",
+                         body ? body->status : 405, !body ? "Method Not Allowed" : body->status == 200 ? "OK" : "Not Found",
+                         body ? body->size : 0, close_after ? "Connection: close\r\n" : "");
+        if (_send_all(fd, header, (size_t)n) != 0) goto done;
+        if (body && _send_all(fd, body->data, body->size) != 0) goto done;
+        if (close_after) goto done;
+
+        // Keep any pipelined request that arrived behind this one
+        memmove(request, request + head, have - head);
+        have -= head;
+    }
+done:
+    close(fd);
+    return NULL;
+}
+
+static void _usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [-p port] [-d fixture_dir] [-l latency_ms] [-j jitter_ms] [-n records]\n"
+            "  -p  port to listen on, on 127.0.0.1 (default 8080)\n"
+            "  -d  directory of recorded responses (default tools/fixtures)\n"
+            "  -l  delay before every response, in ms (default 0)\n"
+            "  -j  extra random delay of up to this many ms (default 0)\n"
+            "  -n  bars, holdings or transcript paragraphs in generated bodies (default 1000)\n",
+            argv0);
+}
+
+int main(int argc, char **argv) {
+    int opt;
+    while ((opt = getopt(argc, argv, "p:d:l:j:n:h")) != -1) {
+        switch (opt) {
+        case 'p': config.port = atoi(optarg); break;
+        case 'd': config.dir = optarg; break;
+        case 'l': config.latency_ms = atoi(optarg); break;
+        case 'j': config.jitter_ms = atoi(optarg); break;
+        case 'n': config.records = atoi(optarg); break;
+        default:
+            _usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)config.port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listener, 512) != 0) {
+        perror("error: cannot listen");
+        return 1;
+    }
+    fprintf(stderr, "axion-mock: serving %s on http://127.0.0.1:%d\n", config.dir, config.port);
+
+    for (;;) {
+        int fd = accept(listener, NULL, NULL);
+        if (fd < 0) continue;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        pthread_t thread;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        if (pthread_create(&thread, &attr, _serve, (void *)(intptr_t)fd) != 0) close(fd);
+        pthread_attr_destroy(&attr);
+    }
+}